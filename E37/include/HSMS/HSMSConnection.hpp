@@ -0,0 +1,214 @@
+#pragma once
+#include <HSMSReactor.hpp>
+#include <HSMSStateMachine.hpp>
+#include <SECSMessage.hpp>
+#include <SECSMessageHeader.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stop_token>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct HSMSConfig {
+  enum class Mode { Active, Passive };
+  Mode mode = Mode::Active;
+  // Numeric address: the peer to connect to (Active) or the local address to
+  // listen on (Passive). Names are not resolved so Open never blocks.
+  std::string host = "127.0.0.1";
+  // 0 lets a passive entity pick a free port; see LocalPort.
+  std::uint16_t port = 5000;
+  std::uint16_t sessionId = 0;
+  // Larger messages are a protocol error and drop the connection.
+  std::size_t maxMessageSize = 16u << 20;
+  // Decode data message bodies into item trees on arrival; otherwise they
+  // are delivered encoded (see SECSMessage::TryDecodeBody).
+  bool decodeBody = true;
+  // E37 timeouts in milliseconds; 0 disables one.
+  // T3: reply; the reply handler gets nullptr.
+  std::uint32_t t3 = 45000;
+  // T5: connect separation; an active entity reconnects this long after
+  // losing or failing to open its connection.
+  std::uint32_t t5 = 10000;
+  // T6: control transaction; the connection is dropped.
+  std::uint32_t t6 = 5000;
+  // T7: not selected after connecting; the connection is dropped.
+  std::uint32_t t7 = 10000;
+  // T8: gap between bytes of one message; the connection is dropped.
+  std::uint32_t t8 = 5000;
+};
+
+// One HSMS-SS (E37.1) connection over a non-blocking TCP socket, driven by
+// an HSMSReactor. Messages are framed by their 4-byte length, control
+// messages are answered here and data messages are handed to the message
+// handler once the connection is selected. The connection state is an
+// HSMSStateMachine and every timeout is a reactor timer, so a connection
+// costs no thread. Every member must be called on the reactor's thread, and
+// the connection must not be destroyed from inside one of its own handlers.
+class HSMSConnection : private HSMSReactor::Handler {
+public:
+  // NotConnected, NotSelected or Selected outside of state handlers.
+  using State = HSMSState;
+  // E37 reject reason codes, sent in header byte 3 of Reject.req.
+  enum class RejectReason : std::uint8_t {
+    STypeNotSupported = 1,
+    PTypeNotSupported = 2,
+    TransactionNotOpen = 3,
+    EntityNotSelected = 4,
+  };
+
+  using MessageHandler = std::function<void(HSMSConnection &, SECSMessage &)>;
+  using StateHandler = std::function<void(HSMSConnection &, State)>;
+  // Receives the reply, or nullptr when the transaction ends without one.
+  using ReplyHandler = std::function<void(HSMSConnection &, SECSMessage *)>;
+
+private:
+  static constexpr std::size_t LengthBytes = 4;
+  static constexpr std::size_t ReadChunk = 64u << 10;
+
+  // Listening socket of a passive entity.
+  class Acceptor : public HSMSReactor::Handler {
+  private:
+    HSMSConnection &owner_;
+
+  public:
+    explicit Acceptor(HSMSConnection &owner) noexcept : owner_(owner) {}
+    void OnEvents(std::uint32_t events) override;
+  };
+
+  HSMSReactor &reactor_;
+  HSMSConfig config_;
+  Acceptor acceptor_;
+  int listen_fd_ = -1;
+  int fd_ = -1;
+  bool connecting_ = false;
+  bool writing_ = false;
+  // set by Close and Separate; an active entity only reconnects while it is
+  // false
+  bool closed_ = true;
+  // Separate.req is queued; the connection drops once it is written
+  bool separating_ = false;
+  // bumped by Drop so receive loops notice a handler closed the connection
+  std::uint64_t generation_ = 0;
+  std::uint32_t next_system_bytes_ = 1;
+
+  std::vector<std::uint8_t> input_;
+  std::size_t input_size_ = 0;
+  std::vector<std::uint8_t> output_;
+  std::size_t output_offset_ = 0;
+
+  // Transactions carry their T6/T3 deadline (tick ms, max() for none).
+  // Each table has at most one queued timer, for its earliest deadline,
+  // which rearms itself for the next one; finished transactions leave
+  // nothing behind in the reactor.
+  struct ControlTransaction {
+    std::uint32_t systemBytes;
+    SECSMessageHeader::SType request;
+    std::uint64_t deadline;
+  };
+  struct ReplyTransaction {
+    ReplyHandler handler;
+    std::uint64_t deadline;
+  };
+  std::vector<ControlTransaction> controls_;
+  std::unordered_map<std::uint32_t, ReplyTransaction> replies_;
+  bool t3_armed_ = false;
+  bool t6_armed_ = false;
+
+  // stopped on destruction so no timer outlives the connection
+  std::stop_source alive_;
+  std::stop_source t5_;
+  std::stop_source t7_;
+  // t8_ holds no stop state while no T8 timer is queued
+  std::stop_source t8_{std::nostopstate};
+  std::uint64_t last_receive_ = 0;
+
+  MessageHandler on_message_;
+  StateHandler on_state_;
+  State notified_ = State::NotConnected;
+  // last, so the listener it calls sees every other member constructed
+  HSMSStateMachine machine_;
+
+  void OnEvents(std::uint32_t events) override;
+  void Accept();
+  bool Attach(int fd, bool connecting);
+  void FinishConnect();
+  void Receive();
+  void Dispatch(const SECSMessageHeader &header,
+                std::span<std::uint8_t> body);
+  void DispatchControl(const SECSMessageHeader &header);
+  void DispatchData(const SECSMessageHeader &header,
+                    std::span<std::uint8_t> body);
+  bool CloseControl(std::uint32_t systemBytes,
+                    SECSMessageHeader::SType request) noexcept;
+  bool SendControl(const SECSMessageHeader &header);
+  bool SendReject(const SECSMessageHeader &header, RejectReason reason);
+  bool Enqueue(const SECSMessage &message);
+  bool Flush();
+  void UpdateInterest() noexcept;
+  // Machine listener; only starts and stops timers, since it runs while
+  // the machine is transiting.
+  void OnStateChanged(State from, State to);
+  // Reports the machine's state to the state handler once it has settled.
+  void NotifyState();
+  // Restarts `timer` to call `expired` after `ms` (nothing when ms is 0).
+  void StartTimer(std::stop_source &timer, std::uint32_t ms,
+                  std::function<void()> expired);
+  // Queues `expired` at `deadline` unless the table's timer is already
+  // queued; deadlines only grow, so the queued one is never later.
+  void ArmDeadline(bool &armed, std::uint64_t deadline,
+                   std::function<void()> expired);
+  void OnT3Expired();
+  void OnT6Expired();
+  bool OpenControl(SECSMessageHeader::SType request);
+  void EndReply(std::uint32_t systemBytes, SECSMessage *reply);
+  void OnT8Expired();
+  // Listens (passive) or starts connecting (active).
+  bool OpenSocket();
+  // Retries an active entity's connection after T5 unless it was closed.
+  void ScheduleReconnect();
+  void Drop();
+
+public:
+  HSMSConnection(HSMSReactor &reactor, HSMSConfig config);
+  ~HSMSConnection();
+  HSMSConnection(const HSMSConnection &) = delete;
+  HSMSConnection &operator=(const HSMSConnection &) = delete;
+
+  const HSMSConfig &Config() const noexcept { return config_; }
+  State GetState() const noexcept { return machine_.Current(); }
+  bool IsSelected() const noexcept { return GetState() == State::Selected; }
+  // Bound port of a passive entity, 0 before Open.
+  std::uint16_t LocalPort() const noexcept;
+
+  void SetMessageHandler(MessageHandler handler) {
+    on_message_ = std::move(handler);
+  }
+  void SetStateHandler(StateHandler handler) { on_state_ = std::move(handler); }
+
+  // Active: starts connecting and sends Select.req once connected; until
+  // Close, lost or failed connections are retried after T5.
+  // Passive: starts listening and accepts one connection at a time.
+  bool Open();
+  // Drops the connection, stops reconnecting and, for a passive entity,
+  // stops listening.
+  void Close();
+
+  // Sends a data message while selected. Primaries get the configured
+  // session ID and fresh system bytes written back into `message`; if
+  // `onReply` is set and the W-bit is on, it is called with the reply, or
+  // with nullptr on Reject.req, T3 or a dropped connection. Replies (even
+  // functions) keep the system bytes of the primary, as SECSMessage::Reply
+  // produces them.
+  bool Send(SECSMessage &message, ReplyHandler onReply = {});
+  bool Select();
+  bool Deselect();
+  bool Linktest();
+  // Sends Separate.req and drops the connection once it is written (or
+  // after T6 if it cannot be); nothing else is sent meanwhile. An active
+  // entity does not reconnect afterwards until Open is called again.
+  bool Separate();
+
+  std::uint32_t NextSystemBytes() noexcept;
+};
@@ -0,0 +1,76 @@
+#pragma once
+#include <LocalTimerBus/TimeDelay.hpp>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <stop_token>
+#include <vector>
+#include <sys/epoll.h>
+
+// Single-threaded epoll event loop. Any number of connections register
+// their sockets here and are driven by whichever thread calls Run/RunOnce;
+// handlers and timers are only ever invoked on that thread. Post and Stop
+// are the only members that may be called from other threads.
+class HSMSReactor {
+public:
+  class Handler {
+  public:
+    virtual ~Handler() = default;
+    // `events` is the epoll event mask that became ready.
+    virtual void OnEvents(std::uint32_t events) = 0;
+  };
+
+private:
+  static constexpr std::size_t MaxEvents = 64;
+  int epoll_fd_ = -1;
+  // eventfd that wakes epoll_wait for Post and Stop
+  int wake_fd_ = -1;
+  std::atomic<bool> stopping_{false};
+  std::mutex mutex_;
+  std::vector<std::function<void()>> posted_;
+  // soonest first; cancelled entries stay queued and do nothing when due
+  std::priority_queue<TimeDelay> timers_;
+  std::array<epoll_event, MaxEvents> events_{};
+  // events_[ready_index_ + 1, ready_count_) are still to be dispatched
+  int ready_count_ = 0;
+  int ready_index_ = 0;
+
+  void Wake() noexcept;
+  void RunPosted();
+  void RunTimers();
+  int TimeoutUntilNextTimer(int timeoutMs) noexcept;
+
+public:
+  HSMSReactor();
+  ~HSMSReactor();
+  HSMSReactor(const HSMSReactor &) = delete;
+  HSMSReactor &operator=(const HSMSReactor &) = delete;
+
+  bool IsOpen() const noexcept { return epoll_fd_ >= 0; }
+
+  bool Add(int fd, std::uint32_t events, Handler *handler) noexcept;
+  bool Modify(int fd, std::uint32_t events, Handler *handler) noexcept;
+  // Safe to call from inside a handler, including for the handler itself;
+  // events already collected for it in the current batch are dropped.
+  void Remove(int fd, Handler *handler) noexcept;
+
+  // Queues `action` to run on the loop thread; thread-safe.
+  void Post(std::function<void()> action);
+  // Runs `action` on the loop thread once `delayMs` milliseconds have passed,
+  // unless `cancel` is stopped first. Loop thread only. A cancelled entry is
+  // only freed when it reaches the front, so per-transaction timeouts should
+  // share one rearmed timer rather than schedule one each.
+  void Schedule(std::uint64_t delayMs, std::function<void()> action,
+                std::stop_token cancel = {});
+  // Waits up to `timeoutMs` (-1 for no limit) or until the next timer is
+  // due, then dispatches socket events, posted actions and due timers.
+  // Returns the number of socket events handled, or -1 on failure.
+  int RunOnce(int timeoutMs = -1);
+  // Dispatches until Stop is called.
+  void Run();
+  // Thread-safe; Run returns after the current batch.
+  void Stop() noexcept;
+};
@@ -0,0 +1,44 @@
+#pragma once
+#include <HSMSConnection.hpp>
+#include <SECSBase.hpp>
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+// An HSMS entity for exercising a connection over loopback without a tool.
+// It answers control messages like any HSMSConnection and replies to every
+// primary that sets the W-bit with whatever `responder` returns (no body
+// when the responder is unset or returns nullptr). Usually run passive on
+// port 0 with the connection under test pointed at LocalPort().
+class HSMSSimulatedPeer {
+public:
+  using Responder =
+      std::function<std::unique_ptr<SECSItemBase>(const SECSMessage &)>;
+
+private:
+  HSMSConnection connection_;
+  Responder responder_;
+  std::size_t received_ = 0;
+
+  void OnMessage(HSMSConnection &connection, SECSMessage &message);
+
+public:
+  explicit HSMSSimulatedPeer(HSMSReactor &reactor, HSMSConfig config = Loopback(),
+                             Responder responder = {});
+
+  // Passive on 127.0.0.1 with an ephemeral port.
+  static HSMSConfig Loopback() {
+    HSMSConfig _config;
+    _config.mode = HSMSConfig::Mode::Passive;
+    _config.port = 0;
+    return _config;
+  }
+
+  bool Open() { return connection_.Open(); }
+  void Close() { connection_.Close(); }
+  HSMSConnection &Connection() noexcept { return connection_; }
+  std::uint16_t LocalPort() const noexcept { return connection_.LocalPort(); }
+  // Data messages received so far, replies included.
+  std::size_t ReceivedCount() const noexcept { return received_; }
+  void SetResponder(Responder responder) { responder_ = std::move(responder); }
+};
@@ -0,0 +1,57 @@
+#pragma once
+#include <FiniteStateMachine/FSM.hpp>
+#include <FiniteStateMachine/State/State.hpp>
+#include <Requirements/VarRefCompareMonitor.hpp>
+#include <VarRef/SourceVarRef.hpp>
+#include <functional>
+#include <memory>
+
+// E37 connection states. Connected is the parent of NotSelected and
+// Selected; Entity is the root that holds the whole model.
+enum class HSMSState { Entity, NotConnected, Connected, NotSelected, Selected };
+
+// The E37 connection model on FSM<HSMSState>:
+//
+//   NOT CONNECTED <-> CONNECTED { NOT SELECTED <-> SELECTED }
+//
+// Each transition is guarded by a RequirementMonitor over two flags the
+// connection sets as events happen, so state changes are pushed through
+// the machine synchronously with no polling. Leaving CONNECTED from either
+// substate is a single transition.
+class HSMSStateMachine {
+public:
+  // Called for every change of the current state, including passing
+  // through Connected on the way to NotSelected.
+  using Listener = std::function<void(HSMSState from, HSMSState to)>;
+
+private:
+  using Subscription = typename FSM<HSMSState>::fsmsubscripte;
+  // declared before the monitors and the machine that observe them
+  SourceVarRef<bool> connected_{false};
+  SourceVarRef<bool> selected_{false};
+  std::unique_ptr<RequirementMonitor> connect_;
+  std::unique_ptr<RequirementMonitor> disconnect_;
+  std::unique_ptr<RequirementMonitor> select_;
+  std::unique_ptr<RequirementMonitor> deselect_;
+  FSM<HSMSState> fsm_;
+  std::unique_ptr<Subscription> subscription_;
+
+  static std::vector<std::unique_ptr<State<HSMSState>>> BuildStates();
+
+public:
+  explicit HSMSStateMachine(Listener listener = {});
+  HSMSStateMachine(const HSMSStateMachine &) = delete;
+  HSMSStateMachine &operator=(const HSMSStateMachine &) = delete;
+
+  HSMSState Current() const noexcept;
+
+  // TCP connection established.
+  void OnConnected() { connected_ = true; }
+  // TCP connection closed, from any connected state.
+  void OnDisconnected() {
+    connected_ = false;
+    selected_ = false;
+  }
+  void OnSelected() { selected_ = true; }
+  void OnDeselected() { selected_ = false; }
+};
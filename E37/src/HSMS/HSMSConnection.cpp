@@ -0,0 +1,745 @@
+#include "HSMSConnection.hpp"
+#include "SECSParser.hpp"
+#include <LocalTimerBus/Tick.hpp>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <string>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+using SType = SECSMessageHeader::SType;
+// Session ID of control messages other than Reject.req.
+constexpr std::uint16_t ControlSessionId = 0xFFFF;
+
+std::uint32_t LoadLength(const std::uint8_t *src) noexcept {
+  return (static_cast<std::uint32_t>(src[0]) << 24) |
+         (static_cast<std::uint32_t>(src[1]) << 16) |
+         (static_cast<std::uint32_t>(src[2]) << 8) | src[3];
+}
+
+void StoreLength(std::uint8_t *dst, std::uint32_t length) noexcept {
+  for (int i = 0; i < 4; i++) {
+    dst[i] = static_cast<std::uint8_t>(length >> ((3 - i) << 3));
+  }
+}
+
+// Tick at which a timeout of `ms` started now expires; 0 disables it.
+std::uint64_t Deadline(std::uint32_t ms) noexcept {
+  return ms == 0 ? std::numeric_limits<std::uint64_t>::max()
+                 : Tick::GetTickCount() + ms;
+}
+
+void SetNoDelay(int fd) noexcept {
+  int _on = 1;
+  ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &_on, sizeof(_on));
+}
+} // namespace
+
+HSMSConnection::HSMSConnection(HSMSReactor &reactor, HSMSConfig config)
+    : reactor_(reactor), config_(std::move(config)), acceptor_(*this),
+      machine_([this](State from, State to) { OnStateChanged(from, to); }) {}
+
+HSMSConnection::~HSMSConnection() {
+  alive_.request_stop();
+  on_message_ = nullptr;
+  on_state_ = nullptr;
+  replies_.clear();
+  Close();
+}
+
+std::uint16_t HSMSConnection::LocalPort() const noexcept {
+  if (listen_fd_ < 0) {
+    return 0;
+  }
+  sockaddr_storage _address{};
+  socklen_t _size = sizeof(_address);
+  if (::getsockname(listen_fd_, reinterpret_cast<sockaddr *>(&_address),
+                    &_size) != 0) {
+    return 0;
+  }
+  if (_address.ss_family == AF_INET6) {
+    return ntohs(reinterpret_cast<sockaddr_in6 *>(&_address)->sin6_port);
+  }
+  return ntohs(reinterpret_cast<sockaddr_in *>(&_address)->sin_port);
+}
+
+bool HSMSConnection::Open() {
+  if (!closed_ || fd_ >= 0 || listen_fd_ >= 0 || !reactor_.IsOpen()) {
+    return false;
+  }
+  closed_ = !OpenSocket();
+  return !closed_;
+}
+
+bool HSMSConnection::OpenSocket() {
+  bool _passive = config_.mode == HSMSConfig::Mode::Passive;
+  addrinfo _hints{};
+  _hints.ai_family = AF_UNSPEC;
+  _hints.ai_socktype = SOCK_STREAM;
+  _hints.ai_flags = AI_NUMERICHOST | AI_NUMERICSERV | (_passive ? AI_PASSIVE : 0);
+  addrinfo *_addresses = nullptr;
+  auto _port = std::to_string(config_.port);
+  if (::getaddrinfo(config_.host.empty() ? nullptr : config_.host.c_str(),
+                    _port.c_str(), &_hints, &_addresses) != 0) {
+    return false;
+  }
+  bool _opened = false;
+  for (auto _address = _addresses; _address && !_opened;
+       _address = _address->ai_next) {
+    int _fd = ::socket(_address->ai_family,
+                       _address->ai_socktype | SOCK_NONBLOCK | SOCK_CLOEXEC,
+                       _address->ai_protocol);
+    if (_fd < 0) {
+      continue;
+    }
+    if (_passive) {
+      int _on = 1;
+      ::setsockopt(_fd, SOL_SOCKET, SO_REUSEADDR, &_on, sizeof(_on));
+      if (::bind(_fd, _address->ai_addr, _address->ai_addrlen) == 0 &&
+          ::listen(_fd, SOMAXCONN) == 0 &&
+          reactor_.Add(_fd, EPOLLIN, &acceptor_)) {
+        listen_fd_ = _fd;
+        _opened = true;
+        continue;
+      }
+    } else {
+      SetNoDelay(_fd);
+      if (::connect(_fd, _address->ai_addr, _address->ai_addrlen) == 0) {
+        _opened = Attach(_fd, false);
+        if (_opened) {
+          machine_.OnConnected();
+          NotifyState();
+          Select();
+        }
+        continue;
+      }
+      if (errno == EINPROGRESS && Attach(_fd, true)) {
+        _opened = true;
+        continue;
+      }
+    }
+    ::close(_fd);
+  }
+  ::freeaddrinfo(_addresses);
+  return _opened;
+}
+
+void HSMSConnection::Close() {
+  closed_ = true;
+  t5_.request_stop();
+  Drop();
+  if (listen_fd_ >= 0) {
+    reactor_.Remove(listen_fd_, &acceptor_);
+    ::close(listen_fd_);
+    listen_fd_ = -1;
+  }
+}
+
+bool HSMSConnection::Attach(int fd, bool connecting) {
+  fd_ = fd;
+  connecting_ = connecting;
+  writing_ = connecting;
+  std::uint32_t _events = EPOLLIN | EPOLLRDHUP | (connecting ? EPOLLOUT : 0u);
+  if (!reactor_.Add(fd, _events, this)) {
+    fd_ = -1;
+    connecting_ = writing_ = false;
+    return false;
+  }
+  return true;
+}
+
+void HSMSConnection::Acceptor::OnEvents([[maybe_unused]] std::uint32_t events) {
+  owner_.Accept();
+}
+
+void HSMSConnection::Accept() {
+  for (;;) {
+    int _fd = ::accept4(listen_fd_, nullptr, nullptr,
+                        SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if (_fd < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return;
+    }
+    // HSMS-SS: a single connection per entity
+    if (fd_ >= 0) {
+      ::close(_fd);
+      continue;
+    }
+    SetNoDelay(_fd);
+    if (!Attach(_fd, false)) {
+      ::close(_fd);
+      continue;
+    }
+    machine_.OnConnected();
+    NotifyState();
+  }
+}
+
+void HSMSConnection::FinishConnect() {
+  int _error = 0;
+  socklen_t _size = sizeof(_error);
+  if (::getsockopt(fd_, SOL_SOCKET, SO_ERROR, &_error, &_size) != 0 ||
+      _error != 0) {
+    Drop();
+    return;
+  }
+  connecting_ = false;
+  UpdateInterest();
+  machine_.OnConnected();
+  NotifyState();
+  Select();
+}
+
+void HSMSConnection::OnEvents(std::uint32_t events) {
+  if (connecting_) {
+    if ((events & (EPOLLOUT | EPOLLERR | EPOLLHUP)) != 0u) {
+      FinishConnect();
+    }
+    return;
+  }
+  auto _generation = generation_;
+  if ((events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) != 0u) {
+    Receive();
+  }
+  if (_generation == generation_ && (events & EPOLLOUT) != 0u) {
+    Flush();
+  }
+}
+
+void HSMSConnection::Receive() {
+  auto _generation = generation_;
+  for (;;) {
+    if (input_.size() - input_size_ < ReadChunk) {
+      input_.resize(input_size_ + ReadChunk);
+    }
+    auto _space = input_.size() - input_size_;
+    auto _read = ::recv(fd_, input_.data() + input_size_, _space, 0);
+    if (_read == 0) {
+      Drop();
+      return;
+    }
+    if (_read < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      if (errno != EAGAIN && errno != EWOULDBLOCK) {
+        Drop();
+      }
+      return;
+    }
+    input_size_ += static_cast<std::size_t>(_read);
+
+    std::size_t _offset = 0;
+    std::size_t _need = 0;
+    while (input_size_ - _offset >= LengthBytes) {
+      auto _length = LoadLength(input_.data() + _offset);
+      if (_length < SECSMessageHeader::Size ||
+          _length > config_.maxMessageSize) {
+        Drop();
+        return;
+      }
+      if (input_size_ - _offset - LengthBytes < _length) {
+        _need = LengthBytes + _length;
+        break;
+      }
+      auto _frame = input_.data() + _offset + LengthBytes;
+      auto _header = SECSMessageHeader::Unpack(
+          std::span<const std::uint8_t, SECSMessageHeader::Size>(
+              _frame, SECSMessageHeader::Size));
+      _offset += LengthBytes + _length;
+      Dispatch(_header,
+               std::span<std::uint8_t>(_frame + SECSMessageHeader::Size,
+                                       _length - SECSMessageHeader::Size));
+      if (_generation != generation_) {
+        return;
+      }
+    }
+    if (_offset != 0) {
+      std::memmove(input_.data(), input_.data() + _offset,
+                   input_size_ - _offset);
+      input_size_ -= _offset;
+    }
+    // size the buffer for the whole of a partially received message
+    if (_need > input_.size()) {
+      input_.resize(_need);
+    }
+    if (input_size_ != 0) {
+      last_receive_ = Tick::GetTickCount();
+      // one queued timer per partial message; see OnT8Expired
+      if (!t8_.stop_possible()) {
+        StartTimer(t8_, config_.t8, [this] { OnT8Expired(); });
+      }
+    }
+    if (static_cast<std::size_t>(_read) < _space) {
+      return;
+    }
+  }
+}
+
+void HSMSConnection::Dispatch(const SECSMessageHeader &header,
+                              std::span<std::uint8_t> body) {
+  if (header.PType() != 0) {
+    SendReject(header, RejectReason::PTypeNotSupported);
+    return;
+  }
+  if (header.IsData()) {
+    DispatchData(header, body);
+  } else {
+    DispatchControl(header);
+  }
+}
+
+void HSMSConnection::OnT8Expired() {
+  t8_ = std::stop_source(std::nostopstate);
+  if (fd_ < 0 || input_size_ == 0) {
+    return;
+  }
+  auto _idle = Tick::GetTickCount() - last_receive_;
+  if (_idle >= config_.t8) {
+    Drop();
+    return;
+  }
+  StartTimer(t8_, config_.t8 - static_cast<std::uint32_t>(_idle),
+             [this] { OnT8Expired(); });
+}
+
+bool HSMSConnection::OpenControl(SType request) {
+  if (fd_ < 0 || connecting_) {
+    return false;
+  }
+  auto _system = NextSystemBytes();
+  auto &_control =
+      controls_.emplace_back(_system, request, Deadline(config_.t6));
+  ArmDeadline(t6_armed_, _control.deadline, [this] { OnT6Expired(); });
+  auto _generation = generation_;
+  if (!SendControl(SECSMessageHeader::Control(request, _system))) {
+    if (_generation == generation_) {
+      CloseControl(_system, request);
+    }
+    return false;
+  }
+  return true;
+}
+
+bool HSMSConnection::CloseControl(std::uint32_t systemBytes,
+                                  SType request) noexcept {
+  auto _it = std::find_if(controls_.begin(), controls_.end(),
+                          [&](const ControlTransaction &open) {
+                            return open.systemBytes == systemBytes &&
+                                   open.request == request;
+                          });
+  if (_it == controls_.end()) {
+    return false;
+  }
+  controls_.erase(_it);
+  return true;
+}
+
+void HSMSConnection::EndReply(std::uint32_t systemBytes, SECSMessage *reply) {
+  auto _it = replies_.find(systemBytes);
+  if (_it == replies_.end()) {
+    return;
+  }
+  auto _handler = std::move(_it->second.handler);
+  replies_.erase(_it);
+  if (_handler) {
+    _handler(*this, reply);
+  }
+}
+
+void HSMSConnection::DispatchControl(const SECSMessageHeader &header) {
+  auto _system = header.SystemBytes();
+  switch (header.GetSType()) {
+  case SType::SelectReq: {
+    // status 1: communication already active
+    std::uint8_t _status = IsSelected() ? 1 : 0;
+    if (SendControl(SECSMessageHeader::Control(SType::SelectRsp, _system,
+                                               ControlSessionId, _status)) &&
+        _status == 0) {
+      machine_.OnSelected();
+      NotifyState();
+    }
+    break;
+  }
+  case SType::SelectRsp:
+    if (!CloseControl(_system, SType::SelectReq)) {
+      SendReject(header, RejectReason::TransactionNotOpen);
+    } else if (header.HeaderByte3() == 0) {
+      machine_.OnSelected();
+      NotifyState();
+    }
+    break;
+  case SType::DeselectReq: {
+    // status 1: communication not established
+    std::uint8_t _status = IsSelected() ? 0 : 1;
+    if (SendControl(SECSMessageHeader::Control(SType::DeselectRsp, _system,
+                                               ControlSessionId, _status)) &&
+        _status == 0) {
+      machine_.OnDeselected();
+      NotifyState();
+    }
+    break;
+  }
+  case SType::DeselectRsp:
+    if (!CloseControl(_system, SType::DeselectReq)) {
+      SendReject(header, RejectReason::TransactionNotOpen);
+    } else if (header.HeaderByte3() == 0) {
+      machine_.OnDeselected();
+      NotifyState();
+    }
+    break;
+  case SType::LinktestReq:
+    SendControl(SECSMessageHeader::Control(SType::LinktestRsp, _system));
+    break;
+  case SType::LinktestRsp:
+    if (!CloseControl(_system, SType::LinktestReq)) {
+      SendReject(header, RejectReason::TransactionNotOpen);
+    }
+    break;
+  case SType::RejectReq:
+    std::erase_if(controls_, [_system](const ControlTransaction &open) {
+      return open.systemBytes == _system;
+    });
+    EndReply(_system, nullptr);
+    break;
+  case SType::SeparateReq:
+    Drop();
+    break;
+  default:
+    SendReject(header, RejectReason::STypeNotSupported);
+    break;
+  }
+}
+
+void HSMSConnection::DispatchData(const SECSMessageHeader &header,
+                                  std::span<std::uint8_t> body) {
+  if (!IsSelected()) {
+    SendReject(header, RejectReason::EntityNotSelected);
+    return;
+  }
+  SECSMessage _message(header);
+  bool _decoded = false;
+  if (config_.decodeBody && !body.empty()) {
+    auto _bytes = body;
+    std::optional<std::unique_ptr<SECSItemBase>> _item;
+    if (SECSParser::TryDeserialize(_bytes, _item) && _item.has_value() &&
+        _bytes.empty()) {
+      _message.SetItem(std::move(_item.value()));
+      _decoded = true;
+    }
+  }
+  // bodies that do not decode are still delivered, encoded
+  if (!_decoded && !body.empty()) {
+    _message.SetBody(std::vector<std::uint8_t>(body.begin(), body.end()));
+  }
+  // even functions and aborts (function 0) answer an earlier primary
+  if ((header.Function() & 1u) == 0u &&
+      replies_.contains(header.SystemBytes())) {
+    EndReply(header.SystemBytes(), &_message);
+    return;
+  }
+  if (on_message_) {
+    on_message_(*this, _message);
+  }
+}
+
+bool HSMSConnection::SendControl(const SECSMessageHeader &header) {
+  if (fd_ < 0 || connecting_) {
+    return false;
+  }
+  return Enqueue(SECSMessage(header));
+}
+
+bool HSMSConnection::SendReject(const SECSMessageHeader &header,
+                                RejectReason reason) {
+  auto _byte2 = reason == RejectReason::PTypeNotSupported
+                    ? header.PType()
+                    : static_cast<std::uint8_t>(header.GetSType());
+  return SendControl(SECSMessageHeader(header.SessionId(), _byte2,
+                                       static_cast<std::uint8_t>(reason), 0,
+                                       SType::RejectReq, header.SystemBytes()));
+}
+
+bool HSMSConnection::Enqueue(const SECSMessage &message) {
+  // nothing follows Separate.req
+  if (separating_) {
+    return false;
+  }
+  auto _size = message.EncodedSize();
+  if (_size == std::numeric_limits<std::size_t>::max() ||
+      _size > std::numeric_limits<std::uint32_t>::max()) {
+    return false;
+  }
+  auto oldSize = output_.size();
+  try {
+    output_.resize(oldSize + LengthBytes);
+  } catch (...) {
+    return false;
+  }
+  StoreLength(output_.data() + oldSize, static_cast<std::uint32_t>(_size));
+  if (!message.TrySerialize(output_)) {
+    output_.resize(oldSize);
+    return false;
+  }
+  return Flush();
+}
+
+bool HSMSConnection::Flush() {
+  while (output_offset_ < output_.size()) {
+    auto _sent = ::send(fd_, output_.data() + output_offset_,
+                        output_.size() - output_offset_, MSG_NOSIGNAL);
+    if (_sent < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        break;
+      }
+      Drop();
+      return false;
+    }
+    output_offset_ += static_cast<std::size_t>(_sent);
+  }
+  if (output_offset_ == output_.size()) {
+    output_.clear();
+    output_offset_ = 0;
+    if (separating_) {
+      Drop();
+      return true;
+    }
+  } else if (output_offset_ * 2 > output_.size()) {
+    output_.erase(output_.begin(),
+                  output_.begin() + static_cast<std::ptrdiff_t>(output_offset_));
+    output_offset_ = 0;
+  }
+  UpdateInterest();
+  return true;
+}
+
+void HSMSConnection::UpdateInterest() noexcept {
+  bool _writing = connecting_ || output_offset_ < output_.size();
+  if (fd_ < 0 || _writing == writing_) {
+    return;
+  }
+  if (reactor_.Modify(fd_,
+                      EPOLLIN | EPOLLRDHUP | (_writing ? EPOLLOUT : 0u),
+                      this)) {
+    writing_ = _writing;
+  }
+}
+
+void HSMSConnection::OnStateChanged(State from, State to) {
+  if (from == State::NotSelected) {
+    t7_.request_stop();
+  }
+  if (to == State::NotSelected) {
+    StartTimer(t7_, config_.t7, [this] { Drop(); });
+  }
+}
+
+void HSMSConnection::NotifyState() {
+  auto _state = machine_.Current();
+  if (_state == notified_ || _state == State::Connected ||
+      _state == State::Entity) {
+    return;
+  }
+  notified_ = _state;
+  if (on_state_) {
+    on_state_(*this, _state);
+  }
+}
+
+void HSMSConnection::StartTimer(std::stop_source &timer, std::uint32_t ms,
+                                std::function<void()> expired) {
+  timer.request_stop();
+  timer = std::stop_source();
+  if (ms == 0) {
+    return;
+  }
+  // a timer due after the connection is destroyed finds alive_ stopped
+  reactor_.Schedule(
+      ms,
+      [_alive = alive_.get_token(), _expired = std::move(expired)] {
+        if (!_alive.stop_requested()) {
+          _expired();
+        }
+      },
+      timer.get_token());
+}
+
+void HSMSConnection::ArmDeadline(bool &armed, std::uint64_t deadline,
+                                 std::function<void()> expired) {
+  if (armed || deadline == std::numeric_limits<std::uint64_t>::max()) {
+    return;
+  }
+  armed = true;
+  auto _now = Tick::GetTickCount();
+  reactor_.Schedule(deadline > _now ? deadline - _now : 0,
+                    [_alive = alive_.get_token(),
+                     _expired = std::move(expired)] {
+                      if (!_alive.stop_requested()) {
+                        _expired();
+                      }
+                    });
+}
+
+void HSMSConnection::OnT3Expired() {
+  t3_armed_ = false;
+  auto _now = Tick::GetTickCount();
+  auto _next = std::numeric_limits<std::uint64_t>::max();
+  std::vector<std::uint32_t> _expired;
+  for (const auto &[_system, _reply] : replies_) {
+    if (_reply.deadline <= _now) {
+      _expired.push_back(_system);
+    } else {
+      _next = std::min(_next, _reply.deadline);
+    }
+  }
+  ArmDeadline(t3_armed_, _next, [this] { OnT3Expired(); });
+  for (auto _system : _expired) {
+    EndReply(_system, nullptr);
+  }
+}
+
+void HSMSConnection::OnT6Expired() {
+  t6_armed_ = false;
+  auto _now = Tick::GetTickCount();
+  auto _next = std::numeric_limits<std::uint64_t>::max();
+  for (const auto &_control : controls_) {
+    if (_control.deadline <= _now) {
+      Drop();
+      return;
+    }
+    _next = std::min(_next, _control.deadline);
+  }
+  ArmDeadline(t6_armed_, _next, [this] { OnT6Expired(); });
+}
+
+void HSMSConnection::ScheduleReconnect() {
+  if (config_.mode != HSMSConfig::Mode::Active || closed_) {
+    return;
+  }
+  if (config_.t5 == 0) {
+    closed_ = true;
+    return;
+  }
+  StartTimer(t5_, config_.t5, [this] {
+    if (!closed_ && fd_ < 0 && !OpenSocket()) {
+      ScheduleReconnect();
+    }
+  });
+}
+
+void HSMSConnection::Drop() {
+  if (fd_ < 0) {
+    return;
+  }
+  reactor_.Remove(fd_, this);
+  ::close(fd_);
+  fd_ = -1;
+  connecting_ = writing_ = separating_ = false;
+  ++generation_;
+  input_size_ = 0;
+  output_.clear();
+  output_offset_ = 0;
+  t7_.request_stop();
+  t8_.request_stop();
+  t8_ = std::stop_source(std::nostopstate);
+  controls_.clear();
+  auto _replies = std::move(replies_);
+  replies_.clear();
+  machine_.OnDisconnected();
+  NotifyState();
+  ScheduleReconnect();
+  for (auto &[_system, _reply] : _replies) {
+    if (_reply.handler) {
+      _reply.handler(*this, nullptr);
+    }
+  }
+}
+
+std::uint32_t HSMSConnection::NextSystemBytes() noexcept {
+  auto _system = next_system_bytes_++;
+  if (next_system_bytes_ == 0) {
+    next_system_bytes_ = 1;
+  }
+  return _system;
+}
+
+bool HSMSConnection::Send(SECSMessage &message, ReplyHandler onReply) {
+  auto &_header = message.Header();
+  if (!IsSelected() || !_header.IsData()) {
+    return false;
+  }
+  bool _primary = (_header.Function() & 1u) != 0u;
+  if (_primary) {
+    _header.SetSessionId(config_.sessionId);
+    _header.SetSystemBytes(NextSystemBytes());
+  }
+  auto _system = _header.SystemBytes();
+  bool _awaits = _primary && _header.NeedReply() && onReply;
+  if (_awaits) {
+    auto &_reply = replies_[_system];
+    _reply = {std::move(onReply), Deadline(config_.t3)};
+    ArmDeadline(t3_armed_, _reply.deadline, [this] { OnT3Expired(); });
+  }
+  auto _generation = generation_;
+  if (!Enqueue(message)) {
+    // a dropped connection has already ended the transaction
+    if (_awaits && _generation == generation_) {
+      replies_.erase(_system);
+    }
+    return false;
+  }
+  return true;
+}
+
+bool HSMSConnection::Select() {
+  if (GetState() != State::NotSelected) {
+    return false;
+  }
+  return OpenControl(SType::SelectReq);
+}
+
+bool HSMSConnection::Deselect() {
+  if (!IsSelected()) {
+    return false;
+  }
+  return OpenControl(SType::DeselectReq);
+}
+
+bool HSMSConnection::Linktest() { return OpenControl(SType::LinktestReq); }
+
+bool HSMSConnection::Separate() {
+  if (!IsSelected() || separating_) {
+    return false;
+  }
+  auto _system = NextSystemBytes();
+  if (!SendControl(SECSMessageHeader::Control(SType::SeparateReq, _system))) {
+    return false;
+  }
+  // a locally initiated separate is not retried; Open starts again
+  if (config_.mode == HSMSConfig::Mode::Active) {
+    closed_ = true;
+    t5_.request_stop();
+  }
+  if (output_.empty()) {
+    Drop();
+    return true;
+  }
+  // Separate.req has no reply; its T6 entry only bounds the wait for the
+  // queued bytes to drain, after which Flush drops the connection
+  separating_ = true;
+  auto &_control =
+      controls_.emplace_back(_system, SType::SeparateReq, Deadline(config_.t6));
+  ArmDeadline(t6_armed_, _control.deadline, [this] { OnT6Expired(); });
+  return true;
+}
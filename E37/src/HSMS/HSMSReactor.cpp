@@ -0,0 +1,185 @@
+#include "HSMSReactor.hpp"
+#include <LocalTimerBus/Tick.hpp>
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+HSMSReactor::HSMSReactor() {
+  epoll_fd_ = ::epoll_create1(EPOLL_CLOEXEC);
+  wake_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (epoll_fd_ < 0 || wake_fd_ < 0) {
+    if (epoll_fd_ >= 0) {
+      ::close(epoll_fd_);
+      epoll_fd_ = -1;
+    }
+    if (wake_fd_ >= 0) {
+      ::close(wake_fd_);
+      wake_fd_ = -1;
+    }
+    return;
+  }
+  // the wake fd is the one registration without a handler
+  epoll_event _event{};
+  _event.events = EPOLLIN;
+  _event.data.ptr = nullptr;
+  if (::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wake_fd_, &_event) != 0) {
+    ::close(epoll_fd_);
+    ::close(wake_fd_);
+    epoll_fd_ = wake_fd_ = -1;
+  }
+}
+
+HSMSReactor::~HSMSReactor() {
+  if (wake_fd_ >= 0) {
+    ::close(wake_fd_);
+  }
+  if (epoll_fd_ >= 0) {
+    ::close(epoll_fd_);
+  }
+}
+
+bool HSMSReactor::Add(int fd, std::uint32_t events, Handler *handler) noexcept {
+  if (!IsOpen() || handler == nullptr) {
+    return false;
+  }
+  epoll_event _event{};
+  _event.events = events;
+  _event.data.ptr = handler;
+  return ::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &_event) == 0;
+}
+
+bool HSMSReactor::Modify(int fd, std::uint32_t events,
+                         Handler *handler) noexcept {
+  if (!IsOpen() || handler == nullptr) {
+    return false;
+  }
+  epoll_event _event{};
+  _event.events = events;
+  _event.data.ptr = handler;
+  return ::epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, fd, &_event) == 0;
+}
+
+void HSMSReactor::Remove(int fd, Handler *handler) noexcept {
+  if (!IsOpen()) {
+    return;
+  }
+  ::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+  for (int i = ready_index_ + 1; i < ready_count_; i++) {
+    if (events_[i].data.ptr == handler) {
+      events_[i].events = 0;
+    }
+  }
+}
+
+void HSMSReactor::Wake() noexcept {
+  std::uint64_t _one = 1;
+  [[maybe_unused]] auto _written = ::write(wake_fd_, &_one, sizeof(_one));
+}
+
+void HSMSReactor::Post(std::function<void()> action) {
+  {
+    std::lock_guard lock(mutex_);
+    posted_.push_back(std::move(action));
+  }
+  Wake();
+}
+
+void HSMSReactor::RunPosted() {
+  std::vector<std::function<void()>> _actions;
+  {
+    std::lock_guard lock(mutex_);
+    _actions.swap(posted_);
+  }
+  for (auto &action : _actions) {
+    if (action) {
+      action();
+    }
+  }
+}
+
+void HSMSReactor::Schedule(std::uint64_t delayMs, std::function<void()> action,
+                           std::stop_token cancel) {
+  timers_.emplace(std::move(action), std::move(cancel),
+                  Tick::GetTickCount() + delayMs);
+}
+
+int HSMSReactor::TimeoutUntilNextTimer(int timeoutMs) noexcept {
+  // cancelled timers at the front would only cause early wake-ups
+  while (!timers_.empty() && timers_.top().Cancelled()) {
+    timers_.pop();
+  }
+  if (timers_.empty()) {
+    return timeoutMs;
+  }
+  auto _now = Tick::GetTickCount();
+  auto _target = timers_.top().TargetTick();
+  int _due = _target <= _now
+                 ? 0
+                 : static_cast<int>(std::min<std::uint64_t>(_target - _now,
+                                                            INT_MAX));
+  return timeoutMs < 0 ? _due : std::min(timeoutMs, _due);
+}
+
+void HSMSReactor::RunTimers() {
+  auto _now = Tick::GetTickCount();
+  while (!timers_.empty() && timers_.top().TargetTick() <= _now) {
+    auto _timer = timers_.top();
+    timers_.pop();
+    _timer.DoAction();
+  }
+}
+
+int HSMSReactor::RunOnce(int timeoutMs) {
+  if (!IsOpen()) {
+    return -1;
+  }
+  int _count =
+      ::epoll_wait(epoll_fd_, events_.data(), static_cast<int>(events_.size()),
+                   TimeoutUntilNextTimer(timeoutMs));
+  if (_count < 0) {
+    if (errno != EINTR) {
+      return -1;
+    }
+    _count = 0;
+  }
+  int _handled = 0;
+  bool _woken = false;
+  ready_count_ = _count;
+  for (ready_index_ = 0; ready_index_ < ready_count_; ready_index_++) {
+    auto &_event = events_[ready_index_];
+    if (_event.data.ptr == nullptr) {
+      std::uint64_t _value;
+      [[maybe_unused]] auto _read = ::read(wake_fd_, &_value, sizeof(_value));
+      _woken = true;
+      continue;
+    }
+    if (_event.events == 0) {
+      continue;
+    }
+    static_cast<Handler *>(_event.data.ptr)->OnEvents(_event.events);
+    ++_handled;
+  }
+  ready_count_ = ready_index_ = 0;
+  if (_woken) {
+    RunPosted();
+  }
+  RunTimers();
+  return _handled;
+}
+
+void HSMSReactor::Run() {
+  while (!stopping_.load(std::memory_order_acquire)) {
+    if (RunOnce() < 0) {
+      break;
+    }
+  }
+  // a Stop only ends the Run it interrupted
+  stopping_.store(false, std::memory_order_release);
+}
+
+void HSMSReactor::Stop() noexcept {
+  stopping_.store(true, std::memory_order_release);
+  Wake();
+}
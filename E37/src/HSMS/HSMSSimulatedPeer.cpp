@@ -0,0 +1,22 @@
+#include "HSMSSimulatedPeer.hpp"
+
+HSMSSimulatedPeer::HSMSSimulatedPeer(HSMSReactor &reactor, HSMSConfig config,
+                                     Responder responder)
+    : connection_(reactor, std::move(config)),
+      responder_(std::move(responder)) {
+  connection_.SetMessageHandler(
+      [this](HSMSConnection &connection, SECSMessage &message) {
+        OnMessage(connection, message);
+      });
+}
+
+void HSMSSimulatedPeer::OnMessage(HSMSConnection &connection,
+                                  SECSMessage &message) {
+  ++received_;
+  const auto &_header = message.Header();
+  if ((_header.Function() & 1u) == 0u || !_header.NeedReply()) {
+    return;
+  }
+  auto _reply = message.Reply(responder_ ? responder_(message) : nullptr);
+  connection.Send(_reply);
+}
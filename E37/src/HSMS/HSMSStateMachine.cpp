@@ -0,0 +1,48 @@
+#include "HSMSStateMachine.hpp"
+
+std::vector<std::unique_ptr<State<HSMSState>>> HSMSStateMachine::BuildStates() {
+  std::vector<std::unique_ptr<State<HSMSState>>> _connected;
+  _connected.push_back(
+      std::make_unique<State<HSMSState>>(HSMSState::NotSelected));
+  _connected.push_back(std::make_unique<State<HSMSState>>(HSMSState::Selected));
+  std::vector<std::unique_ptr<State<HSMSState>>> _states;
+  _states.push_back(
+      std::make_unique<State<HSMSState>>(HSMSState::NotConnected));
+  _states.push_back(std::make_unique<State<HSMSState>>(HSMSState::Connected,
+                                                       std::move(_connected)));
+  return _states;
+}
+
+HSMSStateMachine::HSMSStateMachine(Listener listener)
+    : connect_(EqualTo<bool>(connected_, true)),
+      disconnect_(EqualTo<bool>(connected_, false)),
+      select_(EqualTo<bool>(selected_, true)),
+      deselect_(EqualTo<bool>(selected_, false)),
+      fsm_(HSMSState::Entity, BuildStates()) {
+  // initial substates
+  fsm_.AppendTransition(HSMSState::Entity, HSMSState::NotConnected, nullptr,
+                        {}, false);
+  fsm_.AppendTransition(HSMSState::Connected, HSMSState::NotSelected, nullptr,
+                        {}, false);
+  fsm_.AppendTransition(HSMSState::NotConnected, HSMSState::Connected,
+                        connect_.get(), {}, false);
+  fsm_.AppendTransition(HSMSState::Connected, HSMSState::NotConnected,
+                        disconnect_.get(), {}, false);
+  fsm_.AppendTransition(HSMSState::NotSelected, HSMSState::Selected,
+                        select_.get(), {}, false);
+  fsm_.AppendTransition(HSMSState::Selected, HSMSState::NotSelected,
+                        deselect_.get(), {}, false);
+  if (listener) {
+    subscription_ = std::make_unique<Subscription>(fsm_.subscribe(
+        [_listener = std::move(listener)](const HSMSState &from,
+                                          const HSMSState &to) {
+          _listener(from, to);
+        }));
+  }
+  fsm_.Start();
+}
+
+HSMSState HSMSStateMachine::Current() const noexcept {
+  auto _state = fsm_.CurrentState();
+  return _state ? _state->Index() : HSMSState::Entity;
+}
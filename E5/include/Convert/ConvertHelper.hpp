@@ -7,7 +7,7 @@
 template <typename... Ts>
 bool ConvertToValues(SECSItemBase& item, Ts&... outs)
 {
-    auto list = dynamic_cast<ListItem*>(&item);
+    auto list = item.As<ListItem>();
     if (!list)
         return false;
 
@@ -1,13 +1,18 @@
 #pragma once
 
 #include "SECSBase.hpp"
+#include <cstring>
+#include <span>
+#include <type_traits>
 
 template <typename ItemType, typename ValueType>
 struct ValueItemConverter
 {
+    using item_type = ItemType;
+
     static bool to(SECSItemBase& item, ValueType& value)
     {
-        auto target = dynamic_cast<ItemType*>(&item);
+        auto target = item.As<ItemType>();
         if (!target)
             return false;
 
@@ -19,4 +24,35 @@ struct ValueItemConverter
     {
         return std::make_unique<ItemType>(value);
     }
-};
\ No newline at end of file
+};
+
+// Arithmetic types whose scalar converter names a numeric item, so a
+// contiguous run of them maps onto one array item instead of a List.
+template <typename T>
+concept ArrayElement = std::is_arithmetic_v<T> && !std::is_same_v<T, bool> &&
+    requires { typename SECSConverter<T>::item_type; };
+
+template <ArrayElement T>
+struct ArrayItemConverter
+{
+    using item_type = typename SECSConverter<T>::item_type;
+
+    // Copies into `values`, which must already have the item's length.
+    static bool to(SECSItemBase& item, std::span<T> values)
+    {
+        auto target = item.As<item_type>();
+        if (!target || target->Values().size() != values.size())
+            return false;
+
+        if (!values.empty())
+            std::memcpy(values.data(), target->Values().data(), values.size_bytes());
+        return true;
+    }
+
+    static std::unique_ptr<SECSItemBase> from(std::span<const T> values)
+    {
+        auto item = std::make_unique<item_type>();
+        item->Assign(values);
+        return item;
+    }
+};
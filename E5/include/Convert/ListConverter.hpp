@@ -3,7 +3,7 @@
 #include "ListItem.hpp"
 
 inline bool ConvertOneListElement(
-    const ListItem& list,
+    ListItem& list,
     std::size_t index,
     SECSItemBase*& out)
 {
@@ -11,14 +11,13 @@ inline bool ConvertOneListElement(
         out = nullptr;
         return false;
     }
-    auto& values = list.Values();
-    out = values[index].get();
+    out = list.At(index);
     return out != nullptr;
 }
 
 template <typename T>
 bool ConvertOneListElement(
-    const ListItem& list,
+    ListItem& list,
     std::size_t index,
     T& out)
 {
@@ -34,7 +33,7 @@ bool ConvertOneListElement(
 
 template <typename... Ts, std::size_t... Is>
 bool ConvertListElements(
-    const ListItem& list,
+    ListItem& list,
     std::index_sequence<Is...>,
     Ts&... outs)
 {
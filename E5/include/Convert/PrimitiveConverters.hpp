@@ -1,6 +1,9 @@
 #pragma once
 #include "SECSBase.hpp"
 #include "SECSConverter.hpp"
+#include "SECSConverterImpl.hpp"
+#include <array>
+#include <span>
 #include <vector>
 #include "ListItem.hpp"
 template <typename T>
@@ -8,10 +11,13 @@ struct SECSConverter<std::vector<T>>
 {
     static bool to(SECSItemBase& item, std::vector<T>& value)
     {
-        auto list = dynamic_cast<ListItem*>(&item);
+        auto list = item.As<ListItem>();
         if (!list)
             return false;
 
+        if (!list->TryMaterialize())
+            return false;
+
         std::vector<T> result;
         result.reserve(list->Size());
 
@@ -44,4 +50,56 @@ struct SECSConverter<std::vector<T>>
 
         return std::make_unique<ListItem>(std::move(subItems));
     }
-};
\ No newline at end of file
+};
+
+// Contiguous scalars travel as one array item, e.g. <U4 1 2 3>.
+template <ArrayElement T>
+struct SECSConverter<std::vector<T>>
+{
+    static bool to(SECSItemBase& item, std::vector<T>& value)
+    {
+        auto target = item.As<typename ArrayItemConverter<T>::item_type>();
+        if (!target)
+            return false;
+
+        auto values = target->Values();
+        value.assign(values.begin(), values.end());
+        return true;
+    }
+
+    static std::unique_ptr<SECSItemBase> from(const std::vector<T>& values)
+    {
+        return ArrayItemConverter<T>::from(values);
+    }
+};
+
+template <ArrayElement T, std::size_t N>
+struct SECSConverter<std::array<T, N>>
+{
+    static bool to(SECSItemBase& item, std::array<T, N>& value)
+    {
+        return ArrayItemConverter<T>::to(item, value);
+    }
+
+    static std::unique_ptr<SECSItemBase> from(const std::array<T, N>& values)
+    {
+        return ArrayItemConverter<T>::from(values);
+    }
+};
+
+// Reading into a span fills caller storage of exactly the item's length.
+template <typename T, std::size_t Extent>
+    requires ArrayElement<std::remove_const_t<T>>
+struct SECSConverter<std::span<T, Extent>>
+{
+    static bool to(SECSItemBase& item, std::span<T, Extent>& value)
+        requires(!std::is_const_v<T>)
+    {
+        return ArrayItemConverter<T>::to(item, value);
+    }
+
+    static std::unique_ptr<SECSItemBase> from(std::span<T, Extent> values)
+    {
+        return ArrayItemConverter<std::remove_const_t<T>>::from(values);
+    }
+};
@@ -0,0 +1,418 @@
+#pragma once
+#include "ByteOrder.hpp"
+#include "FormatCode.hpp"
+#include "FormatTraits.hpp"
+#include "SECSItemView.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+// Compile-time message layouts that encode a C++ value straight to SECS-II
+// bytes and decode it straight back, without SECSItemBase or dynamic_cast.
+// S1F3 "L <U4 ...>" for instance is SECSSchema::Vector<SECSSchema::U4> bound
+// to std::vector<std::uint32_t>, and List<...> binds to any aggregate or
+// tuple-like type through structured bindings:
+//
+//   struct Report { std::uint32_t rptid; std::vector<std::uint32_t> vids; };
+//   using ReportSchema = SECSSchema::List<SECSSchema::U4,
+//                                         SECSSchema::Vector<SECSSchema::U4>>;
+//   SECSSchema::TrySerialize<ReportSchema>(report, bytes);
+//
+// Headers of scalars and lists only depend on the schema and are built at
+// compile time; StaticSize is the whole encoding when no part is variable.
+struct SECSSchema
+{
+    static constexpr std::size_t Dynamic = std::numeric_limits<std::size_t>::max();
+
+private:
+    static constexpr std::size_t MaxFields = 12;
+
+    static constexpr std::uint8_t LengthBytesCount(std::size_t length) noexcept
+    {
+        if (length < 0x100)
+            return 1;
+        if (length < 0x10000)
+            return 2;
+        if (length < 0x1000000)
+            return 3;
+        return 0;
+    }
+
+    static constexpr std::size_t HeaderSize(std::size_t length) noexcept
+    {
+        return 1 + LengthBytesCount(length);
+    }
+
+    // Writes the format byte and length field; `bytes` must hold them.
+    static void WriteHeader(std::span<std::uint8_t>& bytes, FormatCode code,
+                            std::size_t length) noexcept
+    {
+        auto byteLength = LengthBytesCount(length);
+        bytes[0] = static_cast<std::uint8_t>(static_cast<int>(code) | byteLength);
+        for (int i = 0; i < byteLength; i++)
+            bytes[1 + i] = static_cast<std::uint8_t>(length >> ((byteLength - 1 - i) << 3));
+        bytes = bytes.subspan(1 + byteLength);
+    }
+
+    template <FormatCode Code, std::size_t Length>
+    static constexpr auto StaticHeader() noexcept
+    {
+        constexpr auto byteLength = LengthBytesCount(Length);
+        static_assert(byteLength != 0, "SECS-II length exceeds 3 bytes");
+        std::array<std::uint8_t, 1 + byteLength> header{};
+        header[0] = static_cast<std::uint8_t>(static_cast<int>(Code) | byteLength);
+        for (std::size_t i = 0; i < byteLength; i++)
+            header[1 + i] = static_cast<std::uint8_t>(Length >> ((byteLength - 1 - i) << 3));
+        return header;
+    }
+
+    template <FormatCode Code, std::size_t Length>
+    static bool WriteStaticHeader(std::span<std::uint8_t>& bytes) noexcept
+    {
+        static constexpr auto header = StaticHeader<Code, Length>();
+        if (bytes.size() < header.size())
+            return false;
+        std::memcpy(bytes.data(), header.data(), header.size());
+        bytes = bytes.subspan(header.size());
+        return true;
+    }
+
+    // Reads a header of format `code` and leaves `bytes` at the payload,
+    // which is known to fit for non-list items.
+    static bool ReadHeader(std::span<const std::uint8_t>& bytes, FormatCode code,
+                           std::uint32_t& length) noexcept
+    {
+        FormatCode format;
+        std::uint8_t headerSize;
+        if (!SECSItemView::ReadHeader(bytes, format, length, headerSize) || format != code)
+            return false;
+        bytes = bytes.subspan(headerSize);
+        return code == FormatCode::ListFormatCode || length <= bytes.size();
+    }
+
+    template <std::size_t N, typename T>
+    static auto Tie(T& value)
+    {
+        static_assert(N <= MaxFields, "SECSSchema::List supports up to 12 fields");
+        if constexpr (requires { std::tuple_size<T>::value; })
+        {
+            return std::apply([](auto&... fields) { return std::tie(fields...); }, value);
+        }
+        else if constexpr (N == 1)
+        {
+            auto& [f0] = value;
+            return std::tie(f0);
+        }
+        else if constexpr (N == 2)
+        {
+            auto& [f0, f1] = value;
+            return std::tie(f0, f1);
+        }
+        else if constexpr (N == 3)
+        {
+            auto& [f0, f1, f2] = value;
+            return std::tie(f0, f1, f2);
+        }
+        else if constexpr (N == 4)
+        {
+            auto& [f0, f1, f2, f3] = value;
+            return std::tie(f0, f1, f2, f3);
+        }
+        else if constexpr (N == 5)
+        {
+            auto& [f0, f1, f2, f3, f4] = value;
+            return std::tie(f0, f1, f2, f3, f4);
+        }
+        else if constexpr (N == 6)
+        {
+            auto& [f0, f1, f2, f3, f4, f5] = value;
+            return std::tie(f0, f1, f2, f3, f4, f5);
+        }
+        else if constexpr (N == 7)
+        {
+            auto& [f0, f1, f2, f3, f4, f5, f6] = value;
+            return std::tie(f0, f1, f2, f3, f4, f5, f6);
+        }
+        else if constexpr (N == 8)
+        {
+            auto& [f0, f1, f2, f3, f4, f5, f6, f7] = value;
+            return std::tie(f0, f1, f2, f3, f4, f5, f6, f7);
+        }
+        else if constexpr (N == 9)
+        {
+            auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8] = value;
+            return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8);
+        }
+        else if constexpr (N == 10)
+        {
+            auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9] = value;
+            return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9);
+        }
+        else if constexpr (N == 11)
+        {
+            auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10] = value;
+            return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10);
+        }
+        else
+        {
+            auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11] = value;
+            return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11);
+        }
+    }
+
+public:
+    // One-element numeric item bound to T.
+    template <typename T, FormatCode Code = FormatTraits::CodeOf<T>()>
+    struct Scalar
+    {
+        static_assert(Code != FormatCode::None, "Scalar needs a numeric or boolean type");
+        static constexpr std::size_t StaticSize = HeaderSize(sizeof(T)) + sizeof(T);
+
+        static std::size_t EncodedSize(const T&) noexcept { return StaticSize; }
+        static bool Encode(std::span<std::uint8_t>& bytes, const T& value) noexcept
+        {
+            if (bytes.size() < StaticSize)
+                return false;
+            WriteStaticHeader<Code, sizeof(T)>(bytes);
+            ByteOrder::StoreBigEndian(bytes.data(), value);
+            bytes = bytes.subspan(sizeof(T));
+            return true;
+        }
+        // Exactly one element is required.
+        static bool Decode(std::span<const std::uint8_t>& bytes, T& value) noexcept
+        {
+            std::uint32_t length;
+            if (!ReadHeader(bytes, Code, length) || length != sizeof(T))
+                return false;
+            value = ByteOrder::LoadBigEndian<T>(bytes.data());
+            bytes = bytes.subspan(length);
+            return true;
+        }
+    };
+
+    // Numeric array item bound to std::vector<T>.
+    template <typename T, FormatCode Code = FormatTraits::CodeOf<T>()>
+    struct Array
+    {
+        static_assert(Code != FormatCode::None && !std::is_same_v<T, bool>,
+                      "Array needs a numeric type");
+        static constexpr std::size_t StaticSize = Dynamic;
+
+        static std::size_t EncodedSize(const std::vector<T>& values) noexcept
+        {
+            auto length = values.size() * sizeof(T);
+            return HeaderSize(length) + length;
+        }
+        static bool Encode(std::span<std::uint8_t>& bytes, const std::vector<T>& values) noexcept
+        {
+            auto length = values.size() * sizeof(T);
+            if (LengthBytesCount(length) == 0 || bytes.size() < HeaderSize(length) + length)
+                return false;
+            WriteHeader(bytes, Code, length);
+            ByteOrder::StoreBigEndian(bytes.data(), values.data(), values.size());
+            bytes = bytes.subspan(length);
+            return true;
+        }
+        static bool Decode(std::span<const std::uint8_t>& bytes, std::vector<T>& values)
+        {
+            std::uint32_t length;
+            if (!ReadHeader(bytes, Code, length) || length % sizeof(T) != 0)
+                return false;
+            values.resize(length / sizeof(T));
+            ByteOrder::LoadBigEndian(values.data(), bytes.data(), values.size());
+            bytes = bytes.subspan(length);
+            return true;
+        }
+    };
+
+    // ASCII item bound to std::string.
+    struct ASCII
+    {
+        static constexpr std::size_t StaticSize = Dynamic;
+
+        static std::size_t EncodedSize(std::string_view text) noexcept
+        {
+            return HeaderSize(text.size()) + text.size();
+        }
+        static bool Encode(std::span<std::uint8_t>& bytes, std::string_view text) noexcept
+        {
+            if (LengthBytesCount(text.size()) == 0 ||
+                bytes.size() < HeaderSize(text.size()) + text.size())
+                return false;
+            WriteHeader(bytes, FormatCode::ASCIIFormatCode, text.size());
+            std::memcpy(bytes.data(), text.data(), text.size());
+            bytes = bytes.subspan(text.size());
+            return true;
+        }
+        static bool Decode(std::span<const std::uint8_t>& bytes, std::string& text)
+        {
+            std::uint32_t length;
+            if (!ReadHeader(bytes, FormatCode::ASCIIFormatCode, length))
+                return false;
+            text.assign(reinterpret_cast<const char*>(bytes.data()), length);
+            bytes = bytes.subspan(length);
+            return true;
+        }
+    };
+
+    // List of any number of Elem items bound to std::vector.
+    template <typename Elem>
+    struct Vector
+    {
+        static constexpr std::size_t StaticSize = Dynamic;
+
+        template <typename T>
+        static std::size_t EncodedSize(const std::vector<T>& values) noexcept
+        {
+            std::size_t total = HeaderSize(values.size());
+            if constexpr (Elem::StaticSize != Dynamic)
+            {
+                total += values.size() * Elem::StaticSize;
+            }
+            else
+            {
+                for (const auto& value : values)
+                    total += Elem::EncodedSize(value);
+            }
+            return total;
+        }
+        template <typename T>
+        static bool Encode(std::span<std::uint8_t>& bytes, const std::vector<T>& values)
+        {
+            if (LengthBytesCount(values.size()) == 0 || bytes.size() < HeaderSize(values.size()))
+                return false;
+            WriteHeader(bytes, FormatCode::ListFormatCode, values.size());
+            for (const auto& value : values)
+            {
+                if (!Elem::Encode(bytes, value))
+                    return false;
+            }
+            return true;
+        }
+        template <typename T>
+        static bool Decode(std::span<const std::uint8_t>& bytes, std::vector<T>& values)
+        {
+            std::uint32_t length;
+            if (!ReadHeader(bytes, FormatCode::ListFormatCode, length))
+                return false;
+            values.clear();
+            // each child takes at least two bytes, so cap what a bogus length reserves
+            values.reserve(std::min<std::size_t>(length, bytes.size() >> 1));
+            for (std::uint32_t i = 0; i < length; i++)
+            {
+                if (!Elem::Decode(bytes, values.emplace_back()))
+                    return false;
+            }
+            return true;
+        }
+    };
+
+    // Fixed list whose children map one-to-one onto the fields of T.
+    template <typename... Fields>
+    struct List
+    {
+        static constexpr std::size_t Count = sizeof...(Fields);
+        static constexpr std::size_t StaticSize =
+            ((Fields::StaticSize != Dynamic) && ...)
+                ? (HeaderSize(Count) + ... + Fields::StaticSize)
+                : Dynamic;
+
+        template <typename T>
+        static std::size_t EncodedSize(const T& value)
+        {
+            if constexpr (StaticSize != Dynamic)
+            {
+                return StaticSize;
+            }
+            else
+            {
+                return std::apply(
+                    [](const auto&... fields) {
+                        return (HeaderSize(Count) + ... + Fields::EncodedSize(fields));
+                    },
+                    Tie<Count>(value));
+            }
+        }
+        template <typename T>
+        static bool Encode(std::span<std::uint8_t>& bytes, const T& value)
+        {
+            if constexpr (StaticSize != Dynamic)
+            {
+                if (bytes.size() < StaticSize)
+                    return false;
+            }
+            if (!WriteStaticHeader<FormatCode::ListFormatCode, Count>(bytes))
+                return false;
+            return std::apply(
+                [&](const auto&... fields) { return (Fields::Encode(bytes, fields) && ...); },
+                Tie<Count>(value));
+        }
+        template <typename T>
+        static bool Decode(std::span<const std::uint8_t>& bytes, T& value)
+        {
+            std::uint32_t length;
+            if (!ReadHeader(bytes, FormatCode::ListFormatCode, length) || length != Count)
+                return false;
+            return std::apply(
+                [&](auto&... fields) { return (Fields::Decode(bytes, fields) && ...); },
+                Tie<Count>(value));
+        }
+    };
+
+    using Boolean = Scalar<bool>;
+    using I1 = Scalar<std::int8_t>;
+    using I2 = Scalar<std::int16_t>;
+    using I4 = Scalar<std::int32_t>;
+    using I8 = Scalar<std::int64_t>;
+    using U1 = Scalar<std::uint8_t>;
+    using U2 = Scalar<std::uint16_t>;
+    using U4 = Scalar<std::uint32_t>;
+    using U8 = Scalar<std::uint64_t>;
+    using F4 = Scalar<float>;
+    using F8 = Scalar<double>;
+    using Binary = Array<std::uint8_t, FormatCode::BinaryFormatCode>;
+
+    // Encodes into an exactly sized buffer appended to `bytes`.
+    template <typename Schema, typename T>
+    static bool TrySerialize(const T& value, std::vector<std::uint8_t>& bytes)
+    {
+        auto oldSize = bytes.size();
+        auto size = Schema::EncodedSize(value);
+        try
+        {
+            bytes.resize(oldSize + size);
+        }
+        catch (...)
+        {
+            return false;
+        }
+        std::span<std::uint8_t> span(bytes.data() + oldSize, size);
+        if (!Schema::Encode(span, value))
+        {
+            bytes.resize(oldSize);
+            return false;
+        }
+        return true;
+    }
+    // Writes at the front of `bytes` and advances it past the encoding.
+    template <typename Schema, typename T>
+    static bool TrySerialize(const T& value, std::span<std::uint8_t>& bytes)
+    {
+        return Schema::Encode(bytes, value);
+    }
+    // Decodes the item at the front of `bytes` and advances it past the item.
+    template <typename Schema, typename T>
+    static bool TryDeserialize(std::span<const std::uint8_t>& bytes, T& value)
+    {
+        return Schema::Decode(bytes, value);
+    }
+};
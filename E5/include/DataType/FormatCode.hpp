@@ -1,8 +1,12 @@
 #pragma once
 #include <array>
-#include <regex>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 
 enum class FormatCode : int {
   None = -1,
@@ -23,20 +27,149 @@ enum class FormatCode : int {
   UInt32FormatCode = 0x2C << 2,
 };
 
+// Name table and hash behind CodeNameExtension, kept apart so the hash can
+// run in CodeNameExtension's constant initializers.
+class CodeNameTable {
+public:
+  struct NamedCode {
+    std::string_view name;
+    FormatCode code;
+  };
+  // The first name of each format is the one written by deparse.
+  static constexpr std::array<NamedCode, 63> namedCodes = {{
+      {"Error", FormatCode::None},
+      {"L", FormatCode::ListFormatCode},
+      {"List", FormatCode::ListFormatCode},
+      {"list", FormatCode::ListFormatCode},
+      {"LIST", FormatCode::ListFormatCode},
+      {"B", FormatCode::BinaryFormatCode},
+      {"Byte", FormatCode::BinaryFormatCode},
+      {"Binary", FormatCode::BinaryFormatCode},
+      {"byte", FormatCode::BinaryFormatCode},
+      {"binary", FormatCode::BinaryFormatCode},
+      {"BOOLEAN", FormatCode::BooleanFormatCode},
+      {"Bool", FormatCode::BooleanFormatCode},
+      {"Boolean", FormatCode::BooleanFormatCode},
+      {"bool", FormatCode::BooleanFormatCode},
+      {"boolean", FormatCode::BooleanFormatCode},
+      {"A", FormatCode::ASCIIFormatCode},
+      {"ASCII", FormatCode::ASCIIFormatCode},
+      {"ascii", FormatCode::ASCIIFormatCode},
+      {"string", FormatCode::ASCIIFormatCode},
+      {"I1", FormatCode::Int8FormatCode},
+      {"Int8", FormatCode::Int8FormatCode},
+      {"i1", FormatCode::Int8FormatCode},
+      {"int8", FormatCode::Int8FormatCode},
+      {"I2", FormatCode::Int16FormatCode},
+      {"i2", FormatCode::Int16FormatCode},
+      {"Int16", FormatCode::Int16FormatCode},
+      {"int16", FormatCode::Int16FormatCode},
+      {"I4", FormatCode::Int32FormatCode},
+      {"i4", FormatCode::Int32FormatCode},
+      {"Int32", FormatCode::Int32FormatCode},
+      {"int32", FormatCode::Int32FormatCode},
+      {"I8", FormatCode::Int64FormatCode},
+      {"Int64", FormatCode::Int64FormatCode},
+      {"i8", FormatCode::Int64FormatCode},
+      {"int64", FormatCode::Int64FormatCode},
+      {"U1", FormatCode::UInt8FormatCode},
+      {"u1", FormatCode::UInt8FormatCode},
+      {"UInt8", FormatCode::UInt8FormatCode},
+      {"Uint8", FormatCode::UInt8FormatCode},
+      {"uint8", FormatCode::UInt8FormatCode},
+      {"U2", FormatCode::UInt16FormatCode},
+      {"u2", FormatCode::UInt16FormatCode},
+      {"UInt16", FormatCode::UInt16FormatCode},
+      {"Uint16", FormatCode::UInt16FormatCode},
+      {"uint16", FormatCode::UInt16FormatCode},
+      {"U4", FormatCode::UInt32FormatCode},
+      {"u4", FormatCode::UInt32FormatCode},
+      {"UInt32", FormatCode::UInt32FormatCode},
+      {"Uint32", FormatCode::UInt32FormatCode},
+      {"uint32", FormatCode::UInt32FormatCode},
+      {"U8", FormatCode::UInt64FormatCode},
+      {"u8", FormatCode::UInt64FormatCode},
+      {"UInt64", FormatCode::UInt64FormatCode},
+      {"Uint64", FormatCode::UInt64FormatCode},
+      {"uint64", FormatCode::UInt64FormatCode},
+      {"F8", FormatCode::DoubleFormatCode},
+      {"D", FormatCode::DoubleFormatCode},
+      {"Double", FormatCode::DoubleFormatCode},
+      {"double", FormatCode::DoubleFormatCode},
+      {"F4", FormatCode::FloatFormatCode},
+      {"F", FormatCode::FloatFormatCode},
+      {"Float", FormatCode::FloatFormatCode},
+      {"float", FormatCode::FloatFormatCode},
+  }};
+  static constexpr std::size_t SlotCount = 512;
+  static constexpr std::uint8_t EmptySlot = 0xFF;
+
+  static constexpr std::size_t Slot(std::string_view name,
+                                    std::uint64_t seed) noexcept {
+    std::uint64_t hash = seed;
+    for (char c : name) {
+      hash = (hash ^ static_cast<std::uint8_t>(c)) * 0x100000001B3ull;
+    }
+    hash ^= hash >> 31;
+    hash *= 0xBF58476D1CE4E5B9ull;
+    hash ^= hash >> 29;
+    return static_cast<std::size_t>(hash) & (SlotCount - 1);
+  }
+  // First seed that sends every name to its own slot.
+  static constexpr std::uint64_t FindSeed() noexcept {
+    for (std::uint64_t seed = 0xCBF29CE484222325ull;;
+         seed += 0x9E3779B97F4A7C15ull) {
+      std::array<bool, SlotCount> used{};
+      bool collision = false;
+      for (std::size_t i = 0; i < namedCodes.size() && !collision; i++) {
+        auto slot = Slot(namedCodes[i].name, seed);
+        collision = used[slot];
+        used[slot] = true;
+      }
+      if (!collision) {
+        return seed;
+      }
+    }
+  }
+  // None, then one slot per six-bit format code.
+  static constexpr std::size_t CodeSlotCount = 65;
+  static constexpr bool HasCodeSlot(FormatCode code) noexcept {
+    auto value = static_cast<int>(code);
+    return value == -1 || (value >= 0 && value <= 0xFC && (value & 3) == 0);
+  }
+  static constexpr std::size_t CodeSlot(FormatCode code) noexcept {
+    return static_cast<std::size_t>(static_cast<int>(code) + 4) >> 2;
+  }
+  // Index of each format's first name in namedCodes, by CodeSlot.
+  static constexpr auto BuildDeparseNames() noexcept {
+    std::array<std::uint8_t, CodeSlotCount> result{};
+    result.fill(EmptySlot);
+    for (std::size_t i = 0; i < namedCodes.size(); i++) {
+      auto &slot = result[CodeSlot(namedCodes[i].code)];
+      if (slot == EmptySlot) {
+        slot = static_cast<std::uint8_t>(i);
+      }
+    }
+    return result;
+  }
+  static constexpr auto BuildSlots(std::uint64_t seed) noexcept {
+    std::array<std::uint8_t, SlotCount> result{};
+    result.fill(EmptySlot);
+    for (std::size_t i = 0; i < namedCodes.size(); i++) {
+      result[Slot(namedCodes[i].name, seed)] = static_cast<std::uint8_t>(i);
+    }
+    return result;
+  }
+};
+
+// SML type names in both directions. The tables are constexpr with a perfect
+// hash for name lookup: string_view in, one hash and one compare, no
+// allocation and no start-up initialization.
 class CodeNameExtension {
 private:
-  static inline std::unordered_map<std::string, FormatCode> namedCodes;
-  static inline std::unordered_map<FormatCode, std::string> codeNames;
-  static constexpr std::array<FormatCode, 15> allFormatCodes = {
-      FormatCode::None, FormatCode::ListFormatCode,
-      FormatCode::BinaryFormatCode, FormatCode::BooleanFormatCode,
-      FormatCode::ASCIIFormatCode,
-      // FormatCode::CharactorFormatCode,
-      FormatCode::Int64FormatCode, FormatCode::Int8FormatCode,
-      FormatCode::Int16FormatCode, FormatCode::Int32FormatCode,
-      FormatCode::DoubleFormatCode, FormatCode::FloatFormatCode,
-      FormatCode::UInt64FormatCode, FormatCode::UInt8FormatCode,
-      FormatCode::UInt16FormatCode, FormatCode::UInt32FormatCode};
+  static constexpr std::uint64_t seed = CodeNameTable::FindSeed();
+  static constexpr auto slots = CodeNameTable::BuildSlots(seed);
+  static constexpr auto deparseNames = CodeNameTable::BuildDeparseNames();
 
 public:
   static std::string getFormatCodeName(FormatCode code);
@@ -44,8 +177,33 @@ public:
   getallFormatMaps();
 
 public:
-  static void Initiation();
-  static std::string GetCodeName(FormatCode code);
-  static FormatCode GetNameCode(const std::string &name);
-  static std::regex ParseReg;
+  // Name written by deparse, e.g. "U4"; throws for unknown codes.
+  static constexpr std::string_view GetCodeName(FormatCode code) {
+    auto index = CodeNameTable::HasCodeSlot(code)
+                     ? deparseNames[CodeNameTable::CodeSlot(code)]
+                     : CodeNameTable::EmptySlot;
+    if (index == CodeNameTable::EmptySlot) {
+      throw std::out_of_range("Key not find in codeNames");
+    }
+    return CodeNameTable::namedCodes[index].name;
+  }
+  static constexpr FormatCode GetNameCode(std::string_view name) {
+    if (name.empty()) {
+      throw std::invalid_argument("name is empty");
+    }
+    auto code = TryGetNameCode(name);
+    if (code == FormatCode::None && name != "Error") {
+      throw std::out_of_range("Key not find in namedCodes");
+    }
+    return code;
+  }
+  // Returns FormatCode::None for unknown names.
+  static constexpr FormatCode TryGetNameCode(std::string_view name) noexcept {
+    auto index = slots[CodeNameTable::Slot(name, seed)];
+    if (index == CodeNameTable::EmptySlot ||
+        CodeNameTable::namedCodes[index].name != name) {
+      return FormatCode::None;
+    }
+    return CodeNameTable::namedCodes[index].code;
+  }
 };
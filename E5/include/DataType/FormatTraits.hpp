@@ -0,0 +1,98 @@
+#pragma once
+#include <FormatCode.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+class FormatTraits {
+public:
+  [[nodiscard]]
+  static constexpr bool IsValid(FormatCode code) noexcept {
+    switch (code) {
+    case FormatCode::ListFormatCode:
+    case FormatCode::BinaryFormatCode:
+    case FormatCode::BooleanFormatCode:
+    case FormatCode::ASCIIFormatCode:
+    case FormatCode::Int64FormatCode:
+    case FormatCode::Int8FormatCode:
+    case FormatCode::Int16FormatCode:
+    case FormatCode::Int32FormatCode:
+    case FormatCode::DoubleFormatCode:
+    case FormatCode::FloatFormatCode:
+    case FormatCode::UInt64FormatCode:
+    case FormatCode::UInt8FormatCode:
+    case FormatCode::UInt16FormatCode:
+    case FormatCode::UInt32FormatCode:
+      return true;
+    default:
+      return false;
+    }
+  }
+  // Width in bytes of one element, 0 for List (its length counts children).
+  [[nodiscard]]
+  static constexpr std::size_t ElemBytesCount(FormatCode code) noexcept {
+    switch (code) {
+    case FormatCode::Int16FormatCode:
+    case FormatCode::UInt16FormatCode:
+      return 2;
+    case FormatCode::Int32FormatCode:
+    case FormatCode::UInt32FormatCode:
+    case FormatCode::FloatFormatCode:
+      return 4;
+    case FormatCode::Int64FormatCode:
+    case FormatCode::UInt64FormatCode:
+    case FormatCode::DoubleFormatCode:
+      return 8;
+    case FormatCode::BinaryFormatCode:
+    case FormatCode::BooleanFormatCode:
+    case FormatCode::ASCIIFormatCode:
+    case FormatCode::Int8FormatCode:
+    case FormatCode::UInt8FormatCode:
+      return 1;
+    default:
+      return 0;
+    }
+  }
+  template <typename T>
+  [[nodiscard]]
+  static constexpr FormatCode CodeOf() noexcept {
+    using U = std::remove_cvref_t<T>;
+    if constexpr (std::is_same_v<U, bool>) {
+      return FormatCode::BooleanFormatCode;
+    } else if constexpr (std::is_same_v<U, std::int8_t>) {
+      return FormatCode::Int8FormatCode;
+    } else if constexpr (std::is_same_v<U, std::int16_t>) {
+      return FormatCode::Int16FormatCode;
+    } else if constexpr (std::is_same_v<U, std::int32_t>) {
+      return FormatCode::Int32FormatCode;
+    } else if constexpr (std::is_same_v<U, std::int64_t>) {
+      return FormatCode::Int64FormatCode;
+    } else if constexpr (std::is_same_v<U, std::uint8_t>) {
+      return FormatCode::UInt8FormatCode;
+    } else if constexpr (std::is_same_v<U, std::uint16_t>) {
+      return FormatCode::UInt16FormatCode;
+    } else if constexpr (std::is_same_v<U, std::uint32_t>) {
+      return FormatCode::UInt32FormatCode;
+    } else if constexpr (std::is_same_v<U, std::uint64_t>) {
+      return FormatCode::UInt64FormatCode;
+    } else if constexpr (std::is_same_v<U, float>) {
+      return FormatCode::FloatFormatCode;
+    } else if constexpr (std::is_same_v<U, double>) {
+      return FormatCode::DoubleFormatCode;
+    } else {
+      return FormatCode::None;
+    }
+  }
+  // Binary payloads are raw bytes, so they are readable as std::uint8_t too.
+  template <typename T>
+  [[nodiscard]]
+  static constexpr bool Matches(FormatCode code) noexcept {
+    using U = std::remove_cvref_t<T>;
+    if constexpr (std::is_same_v<U, std::uint8_t>) {
+      if (code == FormatCode::BinaryFormatCode) {
+        return true;
+      }
+    }
+    return CodeOf<U>() != FormatCode::None && CodeOf<U>() == code;
+  }
+};
@@ -1,24 +1,101 @@
 #pragma once
 #include <FormatCode.hpp>
+#include <SECSItemPool.hpp>
+#include <StringUtils.hpp>
 #include <cstdint>
 #include <limits>
+#include <memory>
+#include <memory_resource>
+#include <new>
 #include <optional>
 #include <span>
+#include <string>
 #include <string_view>
 #include <vector>
 #include "SECSConverter.hpp"
 
+class SECSFactory;
+class SECSHasher;
+
 class SECSItemBase {
+private:
+  // Set by SECSFactory when the node lives in a caller-supplied arena or
+  // in SECSItemPool.
+  std::pmr::memory_resource *resource_ = nullptr;
+  std::size_t footprint_ = 0;
+  bool pooled_ = false;
+  // Fixed at construction so checked downcasts need no RTTI.
+  FormatCode format_ = FormatCode::None;
+  friend class SECSFactory;
+
 public:
   virtual ~SECSItemBase() = default;
+  // Destroying delete lets arena nodes travel in plain
+  // std::unique_ptr<SECSItemBase>: heap nodes go back to ::operator delete,
+  // arena nodes to their resource (a no-op for monotonic resources) and
+  // pooled nodes to their per-format free list.
+  void operator delete(SECSItemBase *item, std::destroying_delete_t) noexcept {
+    auto resource = item->resource_;
+    auto footprint = item->footprint_;
+    auto format = item->format_;
+    auto pooled = item->pooled_;
+    item->~SECSItemBase();
+    if (pooled) {
+      SECSItemPool::Release(format, item, footprint);
+    } else if (resource) {
+      resource->deallocate(item, footprint, alignof(std::max_align_t));
+    } else {
+      ::operator delete(item);
+    }
+  }
+  std::pmr::memory_resource *Resource() const noexcept { return resource_; }
+  FormatCode Format() const noexcept { return format_; }
+  // Checked downcast keyed on the stored format, nullptr on mismatch.
+  template <typename T> T *As() noexcept {
+    return format_ == T::Code ? static_cast<T *>(this) : nullptr;
+  }
+  template <typename T> const T *As() const noexcept {
+    return format_ == T::Code ? static_cast<const T *>(this) : nullptr;
+  }
   virtual FormatCode TryGetFormat() = 0;
   virtual bool TryParseContent(std::string_view) = 0;
   virtual std::string TryDeparseContent(int level = 0) = 0;
+  // Appends the SML text to `builder`; compact writes a single line and
+  // floatFormat selects how F4/F8 values are written. On failure (a lazily
+  // decoded child that does not decode) `builder` is left unchanged.
+  virtual bool TryDeparseContent(
+      std::string &builder, int level = 0, bool compact = false,
+      StringUtils::FloatFormat floatFormat = StringUtils::FloatFormat::Fixed) = 0;
   virtual std::optional<std::vector<std::uint8_t>> TrySerialize() = 0;
   virtual bool TrySerialize(std::vector<std::uint8_t> &) = 0;
+  // Writes the encoded item at the front of `bytes` and advances it past the
+  // written bytes; fails without partial guarantees if `bytes` is too small.
+  virtual bool TrySerialize(std::span<std::uint8_t> &bytes) = 0;
+  // Header plus payload bytes of the whole subtree, max() if not encodable.
+  virtual std::size_t EncodedSize() noexcept {
+    return std::numeric_limits<std::size_t>::max();
+  }
   virtual bool TryDeserialize(std::span<std::uint8_t> &bytes, int length) = 0;
+  // Piecewise payload decoding for SECSStreamDecoder. Leaf items report the
+  // byte width of their elements, size their storage for the first `length`
+  // payload bytes as they arrive (false if that is not a whole number of
+  // elements) and decode `count` whole elements from `src` into place at
+  // element `index`.
+  virtual std::size_t ElementWidth() const noexcept { return 0; }
+  virtual bool TryResizePayload([[maybe_unused]] std::size_t length) {
+    return false;
+  }
+  virtual void LoadElements([[maybe_unused]] std::size_t index,
+                            [[maybe_unused]] const std::uint8_t *src,
+                            [[maybe_unused]] std::size_t count) noexcept {}
   virtual std::size_t Size() noexcept {
     return std::numeric_limits<std::size_t>::max();
+  }
+  // Feeds the subtree to `hasher` as its encoding would (see SECSHasher).
+  virtual void TryHash(SECSHasher &hasher);
+  // Deep structural comparison, stopping at the first difference.
+  virtual bool TryEquals([[maybe_unused]] SECSItemBase &other) {
+    return false;
   }
     template <typename T>
     static bool ConvertTo(SECSItemBase& item, T& value)
@@ -36,4 +113,5 @@ public:
 
 protected:
   SECSItemBase() = default;
+  explicit SECSItemBase(FormatCode format) noexcept : format_(format) {}
 };
@@ -1,8 +1,44 @@
 #pragma once
 #include <FormatCode.hpp>
 #include <SECSBase.hpp>
+#include <SECSItemPool.hpp>
 #include <memory>
+#include <memory_resource>
+#include <new>
 class SECSFactory {
+private:
+  template <typename T>
+  static std::unique_ptr<SECSItemBase>
+  emplaceItem(std::pmr::memory_resource *resource) {
+    if (!resource) {
+      return std::make_unique<T>();
+    }
+    bool pooled = resource == SECSItemPool::Resource();
+    void *memory = pooled
+                       ? SECSItemPool::Acquire(T::Code, sizeof(T))
+                       : resource->allocate(sizeof(T), alignof(std::max_align_t));
+    T *item = nullptr;
+    try {
+      item = ::new (memory) T(resource);
+    } catch (...) {
+      if (pooled) {
+        SECSItemPool::Release(T::Code, memory, sizeof(T));
+      } else {
+        resource->deallocate(memory, sizeof(T), alignof(std::max_align_t));
+      }
+      throw;
+    }
+    item->resource_ = resource;
+    item->footprint_ = sizeof(T);
+    item->pooled_ = pooled;
+    return std::unique_ptr<SECSItemBase>(item);
+  }
+
 public:
   static std::unique_ptr<SECSItemBase> createItem(FormatCode _code);
+  // Places the node and its element storage in `resource`; children decoded
+  // or parsed beneath it follow. nullptr keeps the plain heap path and
+  // SECSItemPool::Resource() recycles nodes through per-format free lists.
+  static std::unique_ptr<SECSItemBase>
+  createItem(FormatCode _code, std::pmr::memory_resource *resource);
 };
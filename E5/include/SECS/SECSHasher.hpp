@@ -0,0 +1,123 @@
+#pragma once
+#include <ByteOrder.hpp>
+#include <FormatCode.hpp>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+
+class SECSItemBase;
+
+// Streaming 64-bit structural hash. Every item contributes its format and
+// length followed by its payload in encoded (big-endian) form, so a tree
+// and its encoding hash identically regardless of how many length bytes
+// the encoder chose. Input is consumed eight bytes at a time and numeric
+// arrays are byte-swapped in blocks, never element by element.
+class SECSHasher {
+private:
+  static constexpr std::uint64_t Prime1 = 0x9E3779B97F4A7C15ull;
+  static constexpr std::uint64_t Prime2 = 0xC2B2AE3D27D4EB4Full;
+  static constexpr std::uint64_t Prime3 = 0x165667B19E3779F9ull;
+  static constexpr std::size_t BlockBytes = 256;
+
+  std::uint64_t state_;
+  std::uint64_t total_ = 0;
+  std::array<std::uint8_t, 8> tail_{};
+  std::size_t tail_size_ = 0;
+
+  void Mix(std::uint64_t word) noexcept {
+    state_ ^= word * Prime1;
+    state_ = std::rotl(state_, 27) * Prime2 + Prime3;
+  }
+  static std::uint64_t Load(const std::uint8_t *src) noexcept {
+    return ByteOrder::LoadBigEndian<std::uint64_t>(src);
+  }
+
+public:
+  explicit SECSHasher(std::uint64_t seed = 0) noexcept
+      : state_(seed ^ Prime3) {}
+
+  void Update(const std::uint8_t *data, std::size_t size) noexcept {
+    total_ += size;
+    if (tail_size_ != 0) {
+      auto _take = std::min(size, tail_.size() - tail_size_);
+      std::memcpy(tail_.data() + tail_size_, data, _take);
+      tail_size_ += _take;
+      data += _take;
+      size -= _take;
+      if (tail_size_ < tail_.size()) {
+        return;
+      }
+      Mix(Load(tail_.data()));
+      tail_size_ = 0;
+    }
+    for (; size >= 8; data += 8, size -= 8) {
+      Mix(Load(data));
+    }
+    if (size != 0) {
+      std::memcpy(tail_.data(), data, size);
+      tail_size_ = size;
+    }
+  }
+  void Update(std::span<const std::uint8_t> bytes) noexcept {
+    Update(bytes.data(), bytes.size());
+  }
+  // Feeds native values as their big-endian encoding.
+  template <typename T> void UpdateBigEndian(std::span<const T> values) noexcept {
+    if constexpr (sizeof(T) == 1 || std::endian::native == std::endian::big) {
+      Update(reinterpret_cast<const std::uint8_t *>(values.data()),
+             values.size_bytes());
+    } else {
+      std::array<std::uint8_t, BlockBytes> _block;
+      constexpr std::size_t _per = BlockBytes / sizeof(T);
+      for (std::size_t i = 0; i < values.size(); i += _per) {
+        auto _count = std::min(_per, values.size() - i);
+        ByteOrder::StoreBigEndian(_block.data(), values.data() + i, _count);
+        Update(_block.data(), _count * sizeof(T));
+      }
+    }
+  }
+  // Format and length of one item: child count for List, payload bytes
+  // otherwise.
+  void Header(FormatCode format, std::uint64_t length) noexcept {
+    std::array<std::uint8_t, 8> _header;
+    ByteOrder::StoreBigEndian(
+        _header.data(),
+        (static_cast<std::uint64_t>(static_cast<std::uint32_t>(format)) << 32) |
+            length);
+    Update(_header.data(), _header.size());
+  }
+  // Feeds one encoded item, validating it; false leaves the state partial.
+  bool UpdateEncoded(std::span<const std::uint8_t> bytes) noexcept;
+  std::uint64_t Finish() const noexcept {
+    auto _hash = state_;
+    if (tail_size_ != 0) {
+      std::array<std::uint8_t, 8> _last{};
+      std::memcpy(_last.data(), tail_.data(), tail_size_);
+      _hash ^= Load(_last.data()) * Prime1;
+      _hash = std::rotl(_hash, 27) * Prime2 + Prime3;
+    }
+    _hash ^= total_;
+    _hash ^= _hash >> 33;
+    _hash *= 0xFF51AFD7ED558CCDull;
+    _hash ^= _hash >> 33;
+    _hash *= 0xC4CEB9FE1A85EC53ull;
+    _hash ^= _hash >> 33;
+    return _hash;
+  }
+
+  static std::uint64_t Hash(SECSItemBase &item, std::uint64_t seed = 0);
+  // Fails on malformed input or trailing bytes.
+  static bool TryHash(std::span<const std::uint8_t> bytes, std::uint64_t &hash,
+                      std::uint64_t seed = 0) noexcept;
+  // Deep comparison that stops at the first difference.
+  static bool Equals(SECSItemBase &lhs, SECSItemBase &rhs);
+  // Compares two encodings item by item, ignoring length-byte widths; false
+  // on malformed input or trailing bytes, as TryHash.
+  static bool Equals(std::span<const std::uint8_t> lhs,
+                     std::span<const std::uint8_t> rhs) noexcept;
+};
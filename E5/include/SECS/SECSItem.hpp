@@ -1,7 +1,14 @@
 #pragma once
 #include <SECSBase.hpp>
 #include <SECS/SECSFactory.hpp>
+#include <SECS/SECSHasher.hpp>
+#include <Utils/ByteOrder.hpp>
+#include <Utils/SmallBuffer.hpp>
 #include <Utils/StringUtils.hpp>
+#include <concepts>
+#include <cstring>
+#include <ranges>
+#include <span>
 #include <sstream>
 #include <string_view>
 
@@ -12,12 +19,16 @@ template <typename Derived>
   requires _SECSConcept<Derived>
 class SECSItem : public SECSItemBase {
 protected:
-  SECSItem() = default;
+  SECSItem() noexcept : SECSItemBase(Derived::Code) {}
   static constexpr char RangeStartMark = '<';
   static constexpr char RangeEndMark = '>';
   static constexpr std::string_view LevelPrefixElem = "  ";
   static constexpr std::size_t _size = LevelPrefixElem.size();
   static constexpr int maxLevel = 150;
+  // Element storage of fixed-width items: single values and short arrays
+  // stay inside the node, longer arrays spill to the node's resource.
+  static constexpr std::size_t InlineStorageBytes = 16;
+  template <typename T> using Storage = SmallBuffer<T, InlineStorageBytes>;
   // static std::string GetPrefix(int level) {
   //     std::ostringstream builder;
   //     for (int i = 0; i < level; i++) {
@@ -25,6 +36,16 @@ protected:
   //     }
   //     return builder.str();
   // }
+  static int LengthBytesCount(std::size_t length) noexcept {
+    if (length < 0x100) {
+      return 1;
+    } else if (length < 0x10000) {
+      return 2;
+    } else if (length < 0x1000000) {
+      return 3;
+    }
+    return 0;
+  }
   static std::string_view GetPrefix(int level) {
     static const std::string prefixes = []() {
       std::string result;
@@ -38,9 +59,7 @@ protected:
   }
 
 public:
-  FormatCode TryGetFormat() override {
-    return static_cast<Derived *>(this)->GetFormat();
-  }
+  FormatCode TryGetFormat() override { return Derived::Code; }
   bool TryParseContent(std::string_view _content) override {
     return static_cast<Derived *>(this)->ParseContent(_content);
   }
@@ -49,13 +68,58 @@ public:
     return static_cast<Derived *>(this)->Size();
   }
 
+  // Empty if the item cannot be written.
   std::string TryDeparseContent(int level = 0) override {
-    std::ostringstream builder;
+    std::string builder;
+    TryDeparseContent(builder, level, false);
+    return builder;
+  }
+  bool TryDeparseContent(std::string &builder, int level = 0,
+                         bool compact = false,
+                         StringUtils::FloatFormat floatFormat =
+                             StringUtils::FloatFormat::Fixed) override {
+    auto _derived = static_cast<Derived *>(this);
+    auto _start = builder.size();
+    if (!compact) {
+      builder += GetPrefix(level);
+    }
+    builder += RangeStartMark;
+    builder += CodeNameExtension::GetCodeName(_derived->GetFormat());
+    // only items that write floats (or hold children) take the format, and
+    // only those holding children can fail
+    auto _content = [&] {
+      if constexpr (requires {
+                      _derived->DeparseContent(builder, level, compact,
+                                               floatFormat);
+                    }) {
+        return _derived->DeparseContent(builder, level, compact, floatFormat);
+      } else {
+        return _derived->DeparseContent(builder, level, compact);
+      }
+    };
+    if constexpr (std::is_void_v<decltype(_content())>) {
+      _content();
+    } else if (!_content()) {
+      builder.resize(_start);
+      return false;
+    }
+    builder += RangeEndMark;
+    return true;
+  }
+  std::size_t EncodedSize() noexcept override {
     auto _derived = static_cast<Derived *>(this);
-    builder << GetPrefix(level) << RangeStartMark
-            << CodeNameExtension::GetCodeName(_derived->GetFormat())
-            << _derived->DeparseContent(level) << RangeEndMark;
-    return builder.str();
+    std::size_t length = _derived->Size();
+    int ByteLength = LengthBytesCount(length);
+    if (ByteLength == 0) {
+      return std::numeric_limits<std::size_t>::max();
+    }
+    if constexpr (requires { _derived->EncodedPayloadSize(); }) {
+      length = _derived->EncodedPayloadSize();
+      if (length == std::numeric_limits<std::size_t>::max()) {
+        return length;
+      }
+    }
+    return 1 + ByteLength + length;
   }
   std::optional<std::vector<std::uint8_t>> TrySerialize() override {
     std::vector<std::uint8_t> builder;
@@ -65,30 +129,127 @@ public:
     return std::nullopt;
   }
   bool TrySerialize(std::vector<std::uint8_t> &bytes) override {
+    std::size_t _size = EncodedSize();
+    if (_size == std::numeric_limits<std::size_t>::max()) {
+      return false;
+    }
+    std::size_t oldSize = bytes.size();
+    try {
+      bytes.resize(oldSize + _size);
+    } catch (...) {
+      return false;
+    }
+    std::span<std::uint8_t> _span(bytes.data() + oldSize, _size);
+    if (!TrySerialize(_span)) {
+      bytes.resize(oldSize);
+      return false;
+    }
+    return true;
+  }
+  bool TrySerialize(std::span<std::uint8_t> &bytes) override {
     auto _derived = static_cast<Derived *>(this);
     std::size_t length = _derived->Size();
-    if (length == std::numeric_limits<std::size_t>::max()) {
+    int ByteLength = LengthBytesCount(length);
+    if (ByteLength == 0) {
       return false;
     }
-    int ByteLength = 0;
-    if (length < 0x100) {
-      ByteLength = 1;
-    } else if (length < 0x10000) {
-      ByteLength = 2;
-    } else if (length < 0x1000000) {
-      ByteLength = 3;
+    // list payloads are checked child by child
+    std::size_t _need = 1 + ByteLength;
+    if (_derived->GetFormat() != FormatCode::ListFormatCode) {
+      _need += length;
+    }
+    if (bytes.size() < _need) {
+      return false;
     }
     auto _formatCode = static_cast<int>(_derived->GetFormat());
-    bytes.reserve(bytes.size() + ByteLength + 1);
-    bytes.emplace_back(static_cast<std::uint8_t>(_formatCode | ByteLength));
+    auto _dst = bytes.data();
+    *_dst++ = static_cast<std::uint8_t>(_formatCode | ByteLength);
     for (int i = ByteLength - 1; i >= 0; i--) {
-      std::uint8_t tmp = (length >> (i << 3));
-      bytes.emplace_back(static_cast<std::uint8_t>(tmp & 0xFF));
+      *_dst++ = static_cast<std::uint8_t>((length >> (i << 3)) & 0xFF);
     }
+    bytes = bytes.subspan(1 + ByteLength);
     return _derived->Serialize(bytes);
   }
   bool TryDeserialize(std::span<std::uint8_t> &bytes, int length) override {
     return static_cast<Derived *>(this)->Deserialize(bytes, length);
   }
+  void TryHash(SECSHasher &hasher) override {
+    auto _derived = static_cast<Derived *>(this);
+    hasher.Header(Derived::Code, _derived->Size());
+    if constexpr (requires { _derived->HashPayload(hasher); }) {
+      _derived->HashPayload(hasher);
+    } else if constexpr (requires { _derived->Values(); }) {
+      hasher.UpdateBigEndian(_derived->Values());
+    } else {
+      auto _text = _derived->Text();
+      hasher.Update(reinterpret_cast<const std::uint8_t *>(_text.data()),
+                    _text.size());
+    }
+  }
+  bool TryEquals(SECSItemBase &other) override {
+    auto _other = other.As<Derived>();
+    if (!_other) {
+      return false;
+    }
+    auto _derived = static_cast<Derived *>(this);
+    if constexpr (requires { _derived->EqualsPayload(*_other); }) {
+      return _derived->EqualsPayload(*_other);
+    } else if constexpr (requires { _derived->Values(); }) {
+      auto _lhs = _derived->Values(), _rhs = _other->Values();
+      return _lhs.size() == _rhs.size() &&
+             (_lhs.empty() ||
+              std::memcmp(_lhs.data(), _rhs.data(), _lhs.size_bytes()) == 0);
+    } else {
+      return _derived->Text() == _other->Text();
+    }
+  }
   virtual ~SECSItem() = default;
 };
+
+// Base of the fixed-width array items (numeric, Binary and Boolean): owns
+// their element storage and the accessors shared by all of them.
+template <typename Derived, typename T>
+class SECSArrayItem : public SECSItem<Derived> {
+protected:
+  using type = T;
+  typename SECSItem<Derived>::template Storage<type> values;
+
+  SECSArrayItem() = default;
+  explicit SECSArrayItem(std::pmr::memory_resource *resource)
+      : values(resource) {}
+
+public:
+  std::span<const type> Values() const noexcept { return values; }
+  // Writable view for in-place updates; Resize first to change the count.
+  std::span<type> MutableValues() noexcept { return values; }
+  void Resize(std::size_t count) { values.resize(count); }
+  template <std::ranges::input_range R>
+    requires std::convertible_to<std::ranges::range_value_t<R>, type>
+  void Assign(R &&range) {
+    if constexpr (std::ranges::contiguous_range<R> &&
+                  std::same_as<std::ranges::range_value_t<R>, type>) {
+      auto _data = std::ranges::data(range);
+      values.assign(_data, _data + std::ranges::size(range));
+    } else {
+      values.clear();
+      if constexpr (std::ranges::sized_range<R>) {
+        values.reserve(std::ranges::size(range));
+      }
+      for (auto &&_value : range) {
+        values.emplace_back(static_cast<type>(_value));
+      }
+    }
+  }
+  std::size_t ElementWidth() const noexcept override { return sizeof(type); }
+  bool TryResizePayload(std::size_t length) override {
+    if (length % sizeof(type) != 0) {
+      return false;
+    }
+    values.resize(length / sizeof(type));
+    return true;
+  }
+  void LoadElements(std::size_t index, const std::uint8_t *src,
+                    std::size_t count) noexcept override {
+    ByteOrder::LoadBigEndian(values.data() + index, src, count);
+  }
+};
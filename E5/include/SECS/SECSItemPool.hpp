@@ -0,0 +1,40 @@
+#pragma once
+#include <FormatCode.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+struct SECSPoolStatistics {
+  std::size_t reused = 0;    // nodes served from a free list
+  std::size_t allocated = 0; // nodes that needed a fresh block
+  std::size_t recycled = 0;  // released nodes kept for reuse
+  std::size_t dropped = 0;   // released nodes freed because the list was full
+  std::size_t cached = 0;    // blocks currently waiting in the free lists
+};
+
+// Thread-local free lists of item node blocks, one per FormatCode. Passing
+// Resource() wherever a memory_resource is accepted (SECSParser,
+// SECSStreamDecoder, SECSFactory::createItem) makes every node of the tree
+// pooled; destroying a pooled node returns its block to the free list of
+// the destroying thread instead of the heap. Once a thread's pool has been
+// destroyed during thread exit, that thread allocates and frees nodes on the
+// heap directly. Element storage is not pooled.
+class SECSItemPool {
+public:
+  static constexpr std::size_t DefaultCapacity = 1024;
+
+  // Tag resource selecting the pooled path; its own allocations go to the
+  // new/delete resource, so it is safe to use from any thread.
+  static std::pmr::memory_resource *Resource() noexcept;
+
+  static void *Acquire(FormatCode code, std::size_t size);
+  static void Release(FormatCode code, void *block, std::size_t size) noexcept;
+
+  // Counters and free lists of the calling thread.
+  static SECSPoolStatistics Statistics(FormatCode code) noexcept;
+  static SECSPoolStatistics Statistics() noexcept;
+  // Upper bound of cached blocks per format for the calling thread.
+  static void SetCapacity(std::size_t capacity) noexcept;
+  // Frees every cached block of the calling thread.
+  static void Trim() noexcept;
+};
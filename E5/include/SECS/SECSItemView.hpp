@@ -0,0 +1,260 @@
+#pragma once
+#include <ByteOrder.hpp>
+#include <FormatCode.hpp>
+#include <FormatTraits.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <span>
+#include <string_view>
+
+// Read-only view over one encoded SECS-II item. Nothing is copied or
+// allocated: the header is decoded on construction and elements are decoded
+// from big-endian on access, so the viewed bytes must outlive the view.
+// Bytes are validated once, by TryParse or SECSValidator; children are then
+// reached with header-only reads that trust them, and a nested list is only
+// walked when stepping over it to a later sibling.
+class SECSItemView {
+private:
+  static constexpr std::uint8_t LengthBytesCountFilter = 0x03;
+  static constexpr std::uint8_t FormatCodeFilter = 0xFC;
+  std::span<const std::uint8_t> bytes_;
+  FormatCode format_ = FormatCode::None;
+  std::uint32_t length_ = 0;
+  std::uint8_t header_size_ = 0;
+  // bytes_ of a list reached by navigation runs on to the end of the
+  // enclosing payload; its own extent is measured on demand
+  bool bounded_ = false;
+
+public:
+  // Decodes the format byte and length field at the front of `bytes`.
+  static bool ReadHeader(std::span<const std::uint8_t> bytes,
+                         FormatCode &format, std::uint32_t &length,
+                         std::uint8_t &headerSize) noexcept {
+    if (bytes.empty()) {
+      return false;
+    }
+    auto bytesFormat = bytes[0];
+    int lengthBytesLength =
+        static_cast<int>(bytesFormat & LengthBytesCountFilter);
+    if (lengthBytesLength == 0 ||
+        lengthBytesLength >= static_cast<int>(bytes.size())) {
+      return false;
+    }
+    format = static_cast<FormatCode>(bytesFormat & FormatCodeFilter);
+    if (!FormatTraits::IsValid(format)) {
+      return false;
+    }
+    length = 0;
+    for (int i = 1; i <= lengthBytesLength; ++i) {
+      length = (length << 8) | bytes[i];
+    }
+    auto _width = FormatTraits::ElemBytesCount(format);
+    if (_width > 1 && (length % _width) != 0) {
+      return false;
+    }
+    headerSize = static_cast<std::uint8_t>(lengthBytesLength + 1);
+    return true;
+  }
+
+private:
+  // Walks the whole subtree without recursion to find where the item ends.
+  static bool Measure(std::span<const std::uint8_t> bytes,
+                      std::size_t &extent) noexcept {
+    std::size_t offset = 0, pending = 1;
+    while (pending > 0) {
+      --pending;
+      FormatCode format;
+      std::uint32_t length;
+      std::uint8_t headerSize;
+      if (!ReadHeader(bytes.subspan(offset), format, length, headerSize)) {
+        return false;
+      }
+      offset += headerSize;
+      auto _remain = bytes.size() - offset;
+      if (format == FormatCode::ListFormatCode) {
+        // every child needs at least a format byte and a length byte
+        pending += length;
+        if (pending > (_remain >> 1)) {
+          return false;
+        }
+      } else {
+        if (length > _remain) {
+          return false;
+        }
+        offset += length;
+      }
+    }
+    extent = offset;
+    return true;
+  }
+
+  // Header-only view of the item at the front of validated bytes.
+  static SECSItemView Trusted(std::span<const std::uint8_t> bytes) noexcept {
+    SECSItemView view;
+    ReadHeader(bytes, view.format_, view.length_, view.header_size_);
+    view.bounded_ = view.IsList();
+    view.bytes_ = view.bounded_
+                      ? bytes
+                      : bytes.first(view.header_size_ + view.length_);
+    return view;
+  }
+  std::size_t Extent() const noexcept {
+    std::size_t extent = bytes_.size();
+    if (bounded_) {
+      Measure(bytes_, extent);
+    }
+    return extent;
+  }
+
+public:
+  class ChildIterator;
+
+  SECSItemView() = default;
+
+  // View of the item at the front of bytes that already passed
+  // SECSValidator::TryValidate; reads only the header.
+  static SECSItemView FromValidated(std::span<const std::uint8_t> bytes) noexcept {
+    if (bytes.empty()) {
+      return SECSItemView{};
+    }
+    return Trusted(bytes);
+  }
+
+  // Parses the item at the front of `bytes` and advances `bytes` past it,
+  // mirroring SECSParser::TryDeserialize. The whole subtree is validated so
+  // later child and element access never reads out of bounds.
+  static bool TryParse(std::span<const std::uint8_t> &bytes,
+                       SECSItemView &view) noexcept {
+    view = SECSItemView{};
+    std::size_t extent = 0;
+    if (!Measure(bytes, extent)) {
+      return false;
+    }
+    ReadHeader(bytes, view.format_, view.length_, view.header_size_);
+    view.bytes_ = bytes.first(extent);
+    bytes = bytes.subspan(extent);
+    return true;
+  }
+
+  bool Valid() const noexcept { return format_ != FormatCode::None; }
+  FormatCode Format() const noexcept { return format_; }
+  bool IsList() const noexcept {
+    return format_ == FormatCode::ListFormatCode;
+  }
+  // Raw header length: child count for List, payload bytes otherwise.
+  std::uint32_t Length() const noexcept { return length_; }
+  std::size_t Count() const noexcept {
+    auto _width = FormatTraits::ElemBytesCount(format_);
+    return _width == 0 ? length_ : length_ / _width;
+  }
+  std::span<const std::uint8_t> Bytes() const noexcept {
+    return bytes_.first(Extent());
+  }
+  std::span<const std::uint8_t> Payload() const noexcept {
+    return Bytes().subspan(header_size_);
+  }
+
+  ChildIterator begin() const noexcept;
+  ChildIterator end() const noexcept;
+
+  // Children are located by stepping over the earlier siblings: a header
+  // read for each leaf, a header walk for each nested list.
+  bool TryGetChild(std::size_t index, SECSItemView &child) const noexcept;
+  SECSItemView operator[](std::size_t index) const noexcept {
+    SECSItemView child;
+    TryGetChild(index, child);
+    return child;
+  }
+
+  template <typename T>
+  bool TryGetValue(std::size_t index, T &value) const noexcept {
+    if (!FormatTraits::Matches<T>(format_) || index >= Count()) {
+      return false;
+    }
+    value = ByteOrder::LoadBigEndian<T>(Payload().data() + index * sizeof(T));
+    return true;
+  }
+  template <typename T> T Value(std::size_t index = 0) const noexcept {
+    T value{};
+    if (!TryGetValue(index, value)) {
+      return T{};
+    }
+    return value;
+  }
+  std::string_view Text() const noexcept {
+    if (format_ != FormatCode::ASCIIFormatCode) {
+      return {};
+    }
+    auto _payload = Payload();
+    return std::string_view(reinterpret_cast<const char *>(_payload.data()),
+                            _payload.size());
+  }
+};
+
+class SECSItemView::ChildIterator {
+private:
+  std::span<const std::uint8_t> rest_;
+  std::size_t remain_ = 0;
+  SECSItemView current_;
+
+  void Load() noexcept {
+    current_ = remain_ == 0 ? SECSItemView{} : SECSItemView::Trusted(rest_);
+  }
+
+public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = SECSItemView;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const SECSItemView *;
+  using reference = const SECSItemView &;
+
+  ChildIterator() = default;
+  // `children` must hold `count` validated items.
+  ChildIterator(std::span<const std::uint8_t> children,
+                std::size_t count) noexcept
+      : rest_(children), remain_(count) {
+    Load();
+  }
+  reference operator*() const noexcept { return current_; }
+  pointer operator->() const noexcept { return &current_; }
+  ChildIterator &operator++() noexcept {
+    rest_ = rest_.subspan(current_.Extent());
+    --remain_;
+    Load();
+    return *this;
+  }
+  ChildIterator operator++(int) noexcept {
+    auto _tmp = *this;
+    ++*this;
+    return _tmp;
+  }
+  bool operator==(const ChildIterator &obj) const noexcept {
+    return remain_ == obj.remain_;
+  }
+};
+
+inline SECSItemView::ChildIterator SECSItemView::begin() const noexcept {
+  if (!IsList()) {
+    return ChildIterator{};
+  }
+  return ChildIterator(bytes_.subspan(header_size_), length_);
+}
+
+inline SECSItemView::ChildIterator SECSItemView::end() const noexcept {
+  return ChildIterator{};
+}
+
+inline bool SECSItemView::TryGetChild(std::size_t index,
+                                      SECSItemView &child) const noexcept {
+  child = SECSItemView{};
+  if (!IsList() || index >= length_) {
+    return false;
+  }
+  auto _it = begin();
+  for (std::size_t i = 0; i < index; i++) {
+    ++_it;
+  }
+  child = *_it;
+  return child.Valid();
+}
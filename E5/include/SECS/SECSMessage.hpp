@@ -0,0 +1,74 @@
+#pragma once
+#include <SECSBase.hpp>
+#include <SECSHead.hpp>
+#include <SECSMessageHeader.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+// One complete SECS message: the 10-byte header plus an optional body. The
+// body is held either as an item tree or as its SECS-II encoding, and is
+// only converted when the other form is asked for, so a relay that never
+// looks inside a message never decodes it.
+class SECSMessage {
+private:
+  SECSMessageHeader header_;
+  std::unique_ptr<SECSItemBase> item_;
+  std::vector<std::uint8_t> body_;
+
+public:
+  SECSMessage() = default;
+  explicit SECSMessage(const SECSMessageHeader &header,
+                       std::unique_ptr<SECSItemBase> item = nullptr) noexcept
+      : header_(header), item_(std::move(item)) {}
+  SECSMessage(const SECSMessageHeader &header,
+              std::vector<std::uint8_t> body) noexcept
+      : header_(header), body_(std::move(body)) {}
+  // A data message addressed by `head`.
+  SECSMessage(std::uint16_t sessionId, const SECSHead &head,
+              std::uint32_t systemBytes,
+              std::unique_ptr<SECSItemBase> item = nullptr) noexcept;
+
+  const SECSMessageHeader &Header() const noexcept { return header_; }
+  SECSMessageHeader &Header() noexcept { return header_; }
+  SECSHead Head() const noexcept {
+    return SECSHead(header_.HeaderByte2(), header_.HeaderByte3());
+  }
+
+  bool HasBody() const noexcept { return item_ != nullptr || !body_.empty(); }
+  // True while the body is held only in encoded form.
+  bool IsEncoded() const noexcept { return item_ == nullptr && !body_.empty(); }
+  // The body as an item tree, or nullptr while it is still encoded.
+  SECSItemBase *Item() const noexcept { return item_.get(); }
+  // The encoded body; empty for an item tree until TryEncodeBody.
+  std::span<const std::uint8_t> Body() const noexcept { return body_; }
+
+  void SetItem(std::unique_ptr<SECSItemBase> item) noexcept;
+  void SetBody(std::vector<std::uint8_t> body) noexcept;
+  std::unique_ptr<SECSItemBase> TakeItem() noexcept;
+
+  // Decodes the encoded body into an item tree; a no-op when it already is
+  // one. The encoded bytes are released on success.
+  bool TryDecodeBody(std::pmr::memory_resource *resource = nullptr);
+  // Encodes the item tree into the body buffer, keeping the tree.
+  bool TryEncodeBody();
+
+  // Header plus encoded body; max() if the body cannot be encoded.
+  std::size_t EncodedSize() const noexcept;
+  // Appends the header followed by the encoded body.
+  bool TrySerialize(std::vector<std::uint8_t> &bytes) const;
+  // Writes at the front of `bytes` and advances it past the message.
+  bool TrySerialize(std::span<std::uint8_t> &bytes) const;
+  // Takes the whole of `bytes` as one message; the body is copied and kept
+  // encoded until TryDecodeBody.
+  static bool TryDeserialize(std::span<const std::uint8_t> bytes,
+                             SECSMessage &message);
+
+  // The reply to this message carrying `item`; see SECSMessageHeader::Reply.
+  SECSMessage Reply(std::unique_ptr<SECSItemBase> item = nullptr) const noexcept {
+    return SECSMessage(header_.Reply(), std::move(item));
+  }
+};
@@ -0,0 +1,208 @@
+#pragma once
+#include <ByteOrder.hpp>
+#include <FormatCode.hpp>
+#include <FormatTraits.hpp>
+#include <SECSBase.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+// Item tree stored as one pre-order array of 16-byte nodes plus one payload
+// buffer holding every leaf's elements in their encoded (big-endian) form.
+// A list's children follow it directly and `extent` skips a whole subtree,
+// so walks, comparisons and re-encoding stream through two flat arrays.
+class SECSMessageTree {
+public:
+  struct Node {
+    FormatCode format = FormatCode::None;
+    // Child count for List, payload bytes otherwise.
+    std::uint32_t length = 0;
+    // Start of the payload in Payload() (leaves only).
+    std::uint32_t offset = 0;
+    // Nodes in this subtree including itself; index + extent is the next
+    // sibling.
+    std::uint32_t extent = 1;
+  };
+
+  class Builder;
+  class ChildIterator;
+
+private:
+  std::vector<Node> nodes_;
+  std::vector<std::uint8_t> payload_;
+
+  static std::size_t HeaderSize(std::size_t length) noexcept;
+
+public:
+  SECSMessageTree() = default;
+
+  // Decodes one encoded item, validating it on the way; `bytes` is advanced
+  // past the item.
+  static bool TryDeserialize(std::span<const std::uint8_t> &bytes,
+                             SECSMessageTree &tree);
+  static bool TryFromItem(SECSItemBase &item, SECSMessageTree &tree);
+  std::unique_ptr<SECSItemBase>
+  ToItem(std::pmr::memory_resource *resource = nullptr) const;
+
+  std::size_t EncodedSize() const noexcept;
+  bool TrySerialize(std::vector<std::uint8_t> &bytes) const;
+  // Writes at the front of `bytes` and advances it past the encoding.
+  bool TrySerialize(std::span<std::uint8_t> &bytes) const noexcept;
+
+  bool Empty() const noexcept { return nodes_.empty(); }
+  std::size_t NodeCount() const noexcept { return nodes_.size(); }
+  const Node &operator[](std::size_t index) const noexcept {
+    return nodes_[index];
+  }
+  std::span<const Node> Nodes() const noexcept { return nodes_; }
+  std::span<const std::uint8_t> Payload() const noexcept { return payload_; }
+  std::span<const std::uint8_t> Payload(std::size_t index) const noexcept {
+    const auto &node = nodes_[index];
+    if (node.format == FormatCode::ListFormatCode) {
+      return {};
+    }
+    return std::span<const std::uint8_t>(payload_).subspan(node.offset,
+                                                           node.length);
+  }
+  std::size_t Count(std::size_t index) const noexcept {
+    const auto &node = nodes_[index];
+    auto _width = FormatTraits::ElemBytesCount(node.format);
+    return _width == 0 ? node.length : node.length / _width;
+  }
+  template <typename T>
+  bool TryGetValue(std::size_t index, std::size_t elem, T &value) const noexcept {
+    if (!FormatTraits::Matches<T>(nodes_[index].format) ||
+        elem >= Count(index)) {
+      return false;
+    }
+    value = ByteOrder::LoadBigEndian<T>(Payload(index).data() +
+                                        elem * sizeof(T));
+    return true;
+  }
+  std::string_view Text(std::size_t index) const noexcept {
+    if (nodes_[index].format != FormatCode::ASCIIFormatCode) {
+      return {};
+    }
+    auto _payload = Payload(index);
+    return std::string_view(reinterpret_cast<const char *>(_payload.data()),
+                            _payload.size());
+  }
+
+  ChildIterator begin(std::size_t index) const noexcept;
+  ChildIterator end(std::size_t index) const noexcept;
+
+  // Calls `visit(index, depth)` for every node in pre-order; returning false
+  // from the visitor skips that node's children.
+  template <typename Visitor> void Visit(Visitor &&visit) const {
+    std::vector<std::uint32_t> _ends;
+    for (std::size_t i = 0; i < nodes_.size();) {
+      while (!_ends.empty() && _ends.back() <= i) {
+        _ends.pop_back();
+      }
+      const auto &node = nodes_[i];
+      bool _descend = true;
+      if constexpr (std::is_void_v<decltype(visit(i, _ends.size()))>) {
+        visit(i, _ends.size());
+      } else {
+        _descend = static_cast<bool>(visit(i, _ends.size()));
+      }
+      if (node.extent > 1 && _descend) {
+        _ends.push_back(static_cast<std::uint32_t>(i + node.extent));
+        ++i;
+      } else {
+        i += node.extent;
+      }
+    }
+  }
+
+  bool operator==(const SECSMessageTree &obj) const noexcept;
+};
+
+class SECSMessageTree::ChildIterator {
+private:
+  const SECSMessageTree *tree_ = nullptr;
+  std::size_t index_ = 0;
+
+public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+
+  ChildIterator() = default;
+  ChildIterator(const SECSMessageTree *tree, std::size_t index) noexcept
+      : tree_(tree), index_(index) {}
+  // Node index of the current child.
+  std::size_t operator*() const noexcept { return index_; }
+  ChildIterator &operator++() noexcept {
+    index_ += tree_->nodes_[index_].extent;
+    return *this;
+  }
+  ChildIterator operator++(int) noexcept {
+    auto _tmp = *this;
+    ++*this;
+    return _tmp;
+  }
+  bool operator==(const ChildIterator &obj) const noexcept {
+    return index_ == obj.index_;
+  }
+};
+
+inline SECSMessageTree::ChildIterator
+SECSMessageTree::begin(std::size_t index) const noexcept {
+  return ChildIterator(this, index + 1);
+}
+
+inline SECSMessageTree::ChildIterator
+SECSMessageTree::end(std::size_t index) const noexcept {
+  return ChildIterator(this, index + nodes_[index].extent);
+}
+
+// Appends nodes in pre-order; lists are opened and closed around their
+// children and their counts and extents are filled in on close.
+class SECSMessageTree::Builder {
+private:
+  SECSMessageTree tree_;
+  std::vector<std::uint32_t> open_;
+
+  bool AddLeaf(FormatCode format, const std::uint8_t *data, std::size_t size);
+
+public:
+  Builder() = default;
+  void Reserve(std::size_t nodes, std::size_t payloadBytes);
+  void BeginList();
+  bool EndList() noexcept;
+  template <typename T> bool Add(std::span<const T> values) {
+    static_assert(FormatTraits::CodeOf<T>() != FormatCode::None,
+                  "Add needs a numeric or boolean element type");
+    auto _offset = tree_.payload_.size();
+    if (!AddLeaf(FormatTraits::CodeOf<T>(), nullptr, values.size_bytes())) {
+      return false;
+    }
+    auto _dst = tree_.payload_.data() + _offset;
+    if constexpr (std::is_same_v<T, bool>) {
+      for (std::size_t i = 0; i < values.size(); i++) {
+        ByteOrder::StoreBigEndian(_dst + i, values[i]);
+      }
+    } else {
+      ByteOrder::StoreBigEndian(_dst, values.data(), values.size());
+    }
+    return true;
+  }
+  template <typename T> bool Add(T value) {
+    return Add(std::span<const T>(&value, 1));
+  }
+  bool AddText(std::string_view text) {
+    return AddLeaf(FormatCode::ASCIIFormatCode,
+                   reinterpret_cast<const std::uint8_t *>(text.data()),
+                   text.size());
+  }
+  bool AddBinary(std::span<const std::uint8_t> bytes) {
+    return AddLeaf(FormatCode::BinaryFormatCode, bytes.data(), bytes.size());
+  }
+  // Fails while a list is still open or if there is more than one root.
+  bool TryBuild(SECSMessageTree &tree);
+};
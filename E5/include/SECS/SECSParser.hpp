@@ -2,53 +2,51 @@
 #include <FormatCode.hpp>
 #include <SECSBase.hpp>
 #include <SECSFactory.hpp>
+#include <SMLParser.hpp>
 #include <StringUtils.hpp>
 #include <memory>
+#include <memory_resource>
 #include <optional>
+// Passing a memory_resource places every decoded node and its element storage
+// in that resource, e.g. a std::pmr::monotonic_buffer_resource per message.
+// The returned tree must be destroyed before the resource is released.
 class SECSParser {
 private:
-  static constexpr char RangeStartMark = '<';
-  static constexpr char RangeEndMark = '>';
   static constexpr std::uint8_t LengthBytesCountFilter = 0x03;
   static constexpr std::uint8_t FormatCodeFilter = 0xFC;
   using ParseResult = std::optional<std::unique_ptr<SECSItemBase>>;
-  static bool GetItemWithoutContent(std::string_view raw, std::string &context,
-                                    std::string &base) noexcept {
-    std::smatch base_match;
-    std::string str{raw};
-    if (std::regex_search(str, base_match, CodeNameExtension::ParseReg)) {
-      if (base_match.size() >= 1) {
-        context = base_match.suffix().str();
-        base = base_match[0].str();
-        return true;
-      }
-    }
-    return false;
-    ;
-  }
 
 public:
-  static ParseResult TryParseContent(std::string_view _Raw) {
-    auto _Trim = StringUtils::trim(_Raw);
-    auto _size = _Trim.size();
-    if (_size < 2 || _Trim[0] != RangeStartMark ||
-        _Trim[_size - 1] != RangeEndMark) {
-      return std::nullopt;
-    }
-    auto _context = _Trim.substr(1, _size - 2);
-    std::string values, matched;
-    if (!GetItemWithoutContent(_context, values, matched)) {
-      return std::nullopt;
+  static ParseResult
+  TryParseContent(std::string_view _Raw,
+                  std::pmr::memory_resource *resource = nullptr) {
+    return SMLParser::Parse(_Raw, nullptr, resource);
+  }
+  static bool TryDeserialize(std::span<std::uint8_t> &bytes,
+                             ParseResult &_item,
+                             std::pmr::memory_resource *resource = nullptr) {
+    std::uint32_t length = 0;
+    if (!TryCreateItem(bytes, _item, length, resource)) {
+      return false;
     }
-    auto _formatCode = CodeNameExtension::GetNameCode(matched);
-    auto _item = SECSFactory::createItem(_formatCode);
-    if (_item && _item->TryParseContent(values)) {
-      return _item;
+    if (!_item.has_value()) {
+      return true;
     }
-    return std::nullopt;
+    return _item.value()->TryDeserialize(bytes, static_cast<int>(length));
   }
-  static bool TryDeserialize(std::span<std::uint8_t> &bytes,
-                             ParseResult &_item) {
+  // Like TryDeserialize, but lists only skip-scan their children and decode
+  // each one on first access (see ListItem::At). Lists copy their encoded
+  // children, so `bytes` may be reused once this returns.
+  static bool
+  TryDeserializeLazy(std::span<std::uint8_t> &bytes, ParseResult &_item,
+                     std::pmr::memory_resource *resource = nullptr);
+
+private:
+  // Reads the header, creates the matching item and leaves `bytes` at its
+  // payload. Empty input succeeds without an item.
+  static bool TryCreateItem(std::span<std::uint8_t> &bytes, ParseResult &_item,
+                            std::uint32_t &length,
+                            std::pmr::memory_resource *resource) {
     _item.reset();
     if (bytes.empty()) {
       return true;
@@ -61,15 +59,16 @@ public:
       return false;
     }
     _item = SECSFactory::createItem(
-        static_cast<FormatCode>(bytesFormat & FormatCodeFilter));
-    if (!_item.has_value()) {
+        static_cast<FormatCode>(bytesFormat & FormatCodeFilter), resource);
+    if (!_item.has_value() || !_item.value()) {
+      _item.reset();
       return false;
     }
-    std::uint32_t length = 0;
+    length = 0;
     for (int i = 1; i <= lengthBytesLength; ++i) {
       length = (length << 8) | bytes[i];
     }
     bytes = bytes.subspan(lengthBytesLength + 1);
-    return _item.value()->TryDeserialize(bytes, static_cast<int>(length));
+    return true;
   }
 };
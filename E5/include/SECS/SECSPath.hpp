@@ -0,0 +1,172 @@
+#pragma once
+#include <SECSItemView.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Compiled query over encoded SECS-II bytes, evaluated through SECSItemView
+// so nothing is decoded into a tree. Steps are separated by '/':
+//   2, *        select child 2 / every child of the current list
+//   U4, L       require the current item to have that format (SML names)
+//   L[2], L[*]  format check followed by child selection
+// e.g. "/2/0/1", "L[*]/U4", or "/2/*/0" for every RPTID of an S6F11 body.
+// Compile once and reuse; ForEach and TryFind never allocate. Queries on raw
+// bytes validate them first, a scan of the whole body; queries on a
+// SECSItemView (from TryParse, or FromValidated for a body SECSValidator
+// already checked) only read the headers along the path.
+class SECSPath {
+private:
+  enum class StepKind : std::uint8_t { Format, Index, Any };
+  struct Step {
+    StepKind kind;
+    FormatCode format;
+    std::uint32_t index;
+  };
+  std::vector<Step> steps_;
+
+  static bool TryParseStep(std::string_view token, std::vector<Step> &steps);
+  // Validated root view, invalid if `bytes` is not a well-formed item.
+  static SECSItemView Parse(std::span<const std::uint8_t> bytes) noexcept {
+    SECSItemView _root;
+    SECSItemView::TryParse(bytes, _root);
+    return _root;
+  }
+
+  // Returns false once `visit` asks to stop.
+  template <typename Visitor>
+  bool Walk(const SECSItemView &item, std::size_t step,
+            Visitor &visit) const {
+    for (; step < steps_.size(); step++) {
+      const auto &_step = steps_[step];
+      if (_step.kind == StepKind::Format) {
+        if (item.Format() != _step.format) {
+          return true;
+        }
+        continue;
+      }
+      if (_step.kind == StepKind::Index) {
+        SECSItemView _child;
+        if (!item.TryGetChild(_step.index, _child)) {
+          return true;
+        }
+        return Walk(_child, step + 1, visit);
+      }
+      for (const auto &_child : item) {
+        if (!Walk(_child, step + 1, visit)) {
+          return false;
+        }
+      }
+      return true;
+    }
+    return visit(item);
+  }
+
+public:
+  SECSPath() = default;
+
+  static bool TryCompile(std::string_view text, SECSPath &path);
+  bool Empty() const noexcept { return steps_.empty(); }
+
+  // Calls `visit(const SECSItemView &)` for every match in document order
+  // until it returns false. Returns the number of matches visited, or 0 if
+  // `root` is not a valid view.
+  template <typename Visitor>
+  std::size_t ForEach(const SECSItemView &root, Visitor &&visit) const {
+    if (!root.Valid()) {
+      return 0;
+    }
+    std::size_t _count = 0;
+    auto _counted = [&](const SECSItemView &item) {
+      ++_count;
+      if constexpr (std::is_void_v<decltype(visit(item))>) {
+        visit(item);
+        return true;
+      } else {
+        return static_cast<bool>(visit(item));
+      }
+    };
+    Walk(root, 0, _counted);
+    return _count;
+  }
+  // As above; 0 if `bytes` does not hold a well-formed item.
+  template <typename Visitor>
+  std::size_t ForEach(std::span<const std::uint8_t> bytes,
+                      Visitor &&visit) const {
+    return ForEach(Parse(bytes), std::forward<Visitor>(visit));
+  }
+
+  bool TryFind(const SECSItemView &root, SECSItemView &item) const {
+    item = SECSItemView{};
+    return ForEach(root, [&](const SECSItemView &match) {
+             item = match;
+             return false;
+           }) != 0;
+  }
+  bool TryFind(std::span<const std::uint8_t> bytes,
+               SECSItemView &item) const {
+    return TryFind(Parse(bytes), item);
+  }
+
+  // Reads the first match the way SECSConverter maps C++ types onto items:
+  // arithmetic types take element 0 of the matching numeric format,
+  // std::string_view / std::string the ASCII text and
+  // std::span<const std::uint8_t> the raw payload.
+  template <typename T>
+  static bool TryRead(const SECSItemView &item, T &value) {
+    using U = std::remove_cvref_t<T>;
+    if constexpr (std::is_arithmetic_v<U>) {
+      return item.TryGetValue(0, value);
+    } else if constexpr (std::is_same_v<U, std::string_view> ||
+                         std::is_same_v<U, std::string>) {
+      if (item.Format() != FormatCode::ASCIIFormatCode) {
+        return false;
+      }
+      value = U(item.Text());
+      return true;
+    } else if constexpr (std::is_same_v<U, std::span<const std::uint8_t>>) {
+      if (!item.Valid() || item.IsList()) {
+        return false;
+      }
+      value = item.Payload();
+      return true;
+    } else {
+      static_assert(!sizeof(U), "Unsupported SECSPath value type");
+    }
+  }
+
+  template <typename T>
+  bool TryGetValue(const SECSItemView &root, T &value) const {
+    SECSItemView _item;
+    return TryFind(root, _item) && TryRead(_item, value);
+  }
+  template <typename T>
+  bool TryGetValue(std::span<const std::uint8_t> bytes, T &value) const {
+    return TryGetValue(Parse(bytes), value);
+  }
+
+  // Appends the value of every match; fails on the first one of another type.
+  template <typename T>
+  bool TryGetValues(const SECSItemView &root, std::vector<T> &values) const {
+    bool _ok = true;
+    ForEach(root, [&](const SECSItemView &item) {
+      T _value{};
+      if (!TryRead(item, _value)) {
+        _ok = false;
+        return false;
+      }
+      values.push_back(std::move(_value));
+      return true;
+    });
+    return _ok;
+  }
+  template <typename T>
+  bool TryGetValues(std::span<const std::uint8_t> bytes,
+                    std::vector<T> &values) const {
+    return TryGetValues(Parse(bytes), values);
+  }
+};
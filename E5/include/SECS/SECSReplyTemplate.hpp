@@ -0,0 +1,121 @@
+#pragma once
+#include <ByteOrder.hpp>
+#include <FormatCode.hpp>
+#include <FormatTraits.hpp>
+#include <SECSBase.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+// A reply body encoded once, with the leaves that change between replies
+// (an ACK code, a DATAID, ...) recorded as slots by SECSPath. Producing a
+// reply is a memcpy of the stored bytes plus a big-endian store per slot;
+// the item tree and SECSItem::TrySerialize are not involved.
+//
+//   SECSReplyTemplate s6f12;
+//   SECSReplyTemplate::TryCompile("<B 0>", {"/"}, s6f12);
+//   s6f12.TryRender(bytes, std::uint8_t{ack});
+class SECSReplyTemplate {
+public:
+  struct Slot {
+    FormatCode format = FormatCode::None;
+    // Payload position and size inside Bytes().
+    std::uint32_t offset = 0;
+    std::uint32_t size = 0;
+  };
+
+private:
+  std::vector<std::uint8_t> bytes_;
+  std::vector<Slot> slots_;
+
+  template <typename T>
+  bool Store(std::uint8_t *message, std::size_t slot, const T &value,
+             std::size_t elem) const noexcept {
+    if (slot >= slots_.size()) {
+      return false;
+    }
+    const auto &_slot = slots_[slot];
+    if constexpr (std::is_convertible_v<const T &, std::string_view>) {
+      // text keeps the template's length, so it must fit exactly
+      std::string_view _text = value;
+      if (_slot.format != FormatCode::ASCIIFormatCode ||
+          _text.size() != _slot.size) {
+        return false;
+      }
+      std::memcpy(message + _slot.offset, _text.data(), _text.size());
+    } else {
+      if (!FormatTraits::Matches<T>(_slot.format) ||
+          (elem + 1) * sizeof(T) > _slot.size) {
+        return false;
+      }
+      ByteOrder::StoreBigEndian(message + _slot.offset + elem * sizeof(T),
+                                value);
+    }
+    return true;
+  }
+
+public:
+  SECSReplyTemplate() = default;
+
+  // Encodes `item` and resolves every path to the first leaf it matches.
+  static bool TryCompile(SECSItemBase &item,
+                         std::initializer_list<std::string_view> slotPaths,
+                         SECSReplyTemplate &reply);
+  static bool TryCompile(std::string_view sml,
+                         std::initializer_list<std::string_view> slotPaths,
+                         SECSReplyTemplate &reply);
+
+  std::span<const std::uint8_t> Bytes() const noexcept { return bytes_; }
+  std::span<const Slot> Slots() const noexcept { return slots_; }
+
+  // Changes the stored default of a slot.
+  template <typename T>
+  bool TrySet(std::size_t slot, const T &value, std::size_t elem = 0) noexcept {
+    return Store(bytes_.data(), slot, value, elem);
+  }
+  // Patches a slot of a message rendered from this template.
+  template <typename T>
+  bool TryPatch(std::span<std::uint8_t> message, std::size_t slot,
+                const T &value, std::size_t elem = 0) const noexcept {
+    return message.size() == bytes_.size() &&
+           Store(message.data(), slot, value, elem);
+  }
+
+  // Writes the stored bytes at the front of `bytes`, patches slot i with the
+  // i-th value and advances `bytes` past the message.
+  template <typename... Ts>
+  bool TryRender(std::span<std::uint8_t> &bytes,
+                 const Ts &...values) const noexcept {
+    if (bytes.size() < bytes_.size() || sizeof...(Ts) > slots_.size()) {
+      return false;
+    }
+    std::memcpy(bytes.data(), bytes_.data(), bytes_.size());
+    std::size_t _slot = 0;
+    if (!(Store(bytes.data(), _slot++, values, 0) && ...)) {
+      return false;
+    }
+    bytes = bytes.subspan(bytes_.size());
+    return true;
+  }
+  // Appends the rendered message to `bytes`.
+  template <typename... Ts>
+  bool TryRender(std::vector<std::uint8_t> &bytes, const Ts &...values) const {
+    auto oldSize = bytes.size();
+    try {
+      bytes.resize(oldSize + bytes_.size());
+    } catch (...) {
+      return false;
+    }
+    std::span<std::uint8_t> _span(bytes.data() + oldSize, bytes_.size());
+    if (!TryRender(_span, values...)) {
+      bytes.resize(oldSize);
+      return false;
+    }
+    return true;
+  }
+};
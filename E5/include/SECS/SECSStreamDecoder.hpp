@@ -0,0 +1,61 @@
+#pragma once
+#include <SECSBase.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+class ListItem;
+
+// Push-style SECS-II decoder for bytes arriving in arbitrary chunks. Open
+// lists are tracked on an explicit stack and nodes are attached as soon as
+// their header is read. A leaf's storage grows with the payload bytes that
+// have arrived and each chunk is decoded straight into it, so a payload
+// split across chunks is never re-buffered and a header alone allocates
+// nothing; only an element straddling two chunks is carried.
+class SECSStreamDecoder {
+public:
+  enum class Status { NeedMore, Complete, Error };
+
+private:
+  static constexpr std::uint8_t LengthBytesCountFilter = 0x03;
+  static constexpr std::uint8_t FormatCodeFilter = 0xFC;
+  struct Frame {
+    ListItem *list;
+    std::uint32_t remain;
+  };
+  std::size_t max_depth_;
+  std::pmr::memory_resource *resource_;
+  std::unique_ptr<SECSItemBase> root_;
+  std::vector<Frame> stack_;
+  std::array<std::uint8_t, 4> header_{};
+  std::size_t header_fill_ = 0;
+  SECSItemBase *leaf_ = nullptr;
+  std::size_t leaf_width_ = 0;
+  // payload bytes still to come and elements decoded so far
+  std::uint32_t leaf_remain_ = 0;
+  std::size_t leaf_index_ = 0;
+  // leading bytes of an element split across chunks, at most width - 1
+  std::array<std::uint8_t, 8> carry_{};
+  std::size_t carry_size_ = 0;
+  Status status_ = Status::NeedMore;
+
+  bool BeginItem();
+  bool FillLeaf(std::span<std::uint8_t> &chunk);
+  void EndItem() noexcept;
+
+public:
+  explicit SECSStreamDecoder(std::size_t maxDepth = 64,
+                             std::pmr::memory_resource *resource = nullptr);
+
+  // Consumes bytes from the front of `chunk`. Stops right after a complete
+  // top-level item, leaving any following bytes in `chunk`.
+  Status Feed(std::span<std::uint8_t> &chunk);
+  Status GetStatus() const noexcept { return status_; }
+  // Hands out the completed item and readies the decoder for the next one.
+  std::unique_ptr<SECSItemBase> Take();
+  void Reset() noexcept;
+};
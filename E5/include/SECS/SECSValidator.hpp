@@ -0,0 +1,68 @@
+#pragma once
+#include <SECSItemView.hpp>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+struct SECSValidationResult {
+  std::size_t itemCount = 0;
+  std::size_t maxDepth = 0;
+  std::size_t payloadBytes = 0;
+};
+
+// Structural check of an encoded message body before anything is decoded:
+// header lengths fit the buffer, element sizes divide their width, every list
+// gets all of its children, nesting stays within a fixed-size stack and no
+// bytes trail the item. Runs iteratively and never allocates.
+class SECSValidator {
+public:
+  static constexpr std::size_t MaxDepth = 64;
+
+  static bool TryValidate(std::span<const std::uint8_t> bytes,
+                          SECSValidationResult &result,
+                          std::size_t maxDepth = MaxDepth) noexcept {
+    result = SECSValidationResult{};
+    if (bytes.empty()) {
+      return true;
+    }
+    maxDepth = std::clamp<std::size_t>(maxDepth, 1, MaxDepth);
+    std::array<std::uint32_t, MaxDepth> remain;
+    std::size_t depth = 0, offset = 0;
+    for (;;) {
+      FormatCode format;
+      std::uint32_t length;
+      std::uint8_t headerSize;
+      if (!SECSItemView::ReadHeader(bytes.subspan(offset), format, length,
+                                    headerSize)) {
+        return false;
+      }
+      offset += headerSize;
+      ++result.itemCount;
+      result.maxDepth = std::max(result.maxDepth, depth + 1);
+      if (format == FormatCode::ListFormatCode) {
+        if (length != 0) {
+          if (depth >= maxDepth - 1) {
+            return false;
+          }
+          remain[depth++] = length;
+          continue;
+        }
+      } else {
+        if (length > bytes.size() - offset) {
+          return false;
+        }
+        offset += length;
+        result.payloadBytes += length;
+      }
+      while (depth > 0 && --remain[depth - 1] == 0) {
+        --depth;
+      }
+      if (depth == 0) {
+        break;
+      }
+    }
+    return offset == bytes.size();
+  }
+};
@@ -0,0 +1,31 @@
+#pragma once
+#include <SECSBase.hpp>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <string_view>
+
+class ListItem;
+
+struct SMLParseError {
+  std::size_t offset = 0;
+  std::string_view reason;
+};
+
+// Recursive-descent SML reader. The text is walked once, type names are
+// resolved in place and list children are attached as they are read, so no
+// substring is scanned twice. On failure `error` receives the byte offset.
+class SMLParser {
+public:
+  using ParseResult = std::optional<std::unique_ptr<SECSItemBase>>;
+  static constexpr int MaxDepth = 150;
+
+  static ParseResult Parse(std::string_view text,
+                           SMLParseError *error = nullptr,
+                           std::pmr::memory_resource *resource = nullptr);
+  // Reads a whitespace separated sequence of items into `list`, replacing its
+  // children. Nodes are placed in list.Resource().
+  static bool ParseItems(std::string_view text, ListItem &list,
+                         SMLParseError *error = nullptr);
+};
@@ -10,10 +10,17 @@ class SentinelSECSItem final : public SECSItemBase {
   std::string TryDeparseContent([[maybe_unused]] int level = 0) override {
     return {};
   }
+  bool TryDeparseContent(std::string &, [[maybe_unused]] int level = 0,
+                         [[maybe_unused]] bool compact = false,
+                         [[maybe_unused]] StringUtils::FloatFormat floatFormat =
+                             StringUtils::FloatFormat::Fixed) override {
+    return false;
+  }
   std::optional<std::vector<std::uint8_t>> TrySerialize() override {
     return std::nullopt;
   }
   bool TrySerialize(std::vector<std::uint8_t> &) override { return false; }
+  bool TrySerialize(std::span<std::uint8_t> &) override { return false; }
   bool TryDeserialize(std::span<std::uint8_t> &, int) override {
     return false;
     ;
@@ -0,0 +1,145 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+// The 10-byte message header shared by HSMS (E37) and SECS-I (E4):
+//
+//   0-1  session ID (device ID)     4    PType, 0 for SECS-II
+//   2    W-bit | stream             5    SType, 0 for data messages
+//   3    function                   6-9  system bytes
+//
+// Bytes 2 and 3 carry the stream and function only in data messages; control
+// messages use them as status codes. Pack and Unpack work in place on the
+// caller's bytes and are usable in constant expressions.
+class SECSMessageHeader {
+public:
+  static constexpr std::size_t Size = 10;
+  static constexpr std::uint8_t WBitFlag = 0x80;
+  static constexpr std::uint8_t StreamFilter = 0x7F;
+
+  enum class SType : std::uint8_t {
+    DataMessage = 0,
+    SelectReq = 1,
+    SelectRsp = 2,
+    DeselectReq = 3,
+    DeselectRsp = 4,
+    LinktestReq = 5,
+    LinktestRsp = 6,
+    RejectReq = 7,
+    SeparateReq = 9,
+  };
+
+private:
+  std::uint16_t session_id_ = 0;
+  std::uint8_t header_byte2_ = 0;
+  std::uint8_t header_byte3_ = 0;
+  std::uint8_t ptype_ = 0;
+  SType stype_ = SType::DataMessage;
+  std::uint32_t system_bytes_ = 0;
+
+public:
+  constexpr SECSMessageHeader() noexcept = default;
+  constexpr SECSMessageHeader(std::uint16_t sessionId, std::uint8_t headerByte2,
+                              std::uint8_t headerByte3, std::uint8_t ptype,
+                              SType stype, std::uint32_t systemBytes) noexcept
+      : session_id_(sessionId), header_byte2_(headerByte2),
+        header_byte3_(headerByte3), ptype_(ptype), stype_(stype),
+        system_bytes_(systemBytes) {}
+
+  // A SECS-II data message; the W-bit is dropped for even (reply) functions.
+  static constexpr SECSMessageHeader Data(std::uint16_t sessionId,
+                                          std::uint8_t stream,
+                                          std::uint8_t function, bool needReply,
+                                          std::uint32_t systemBytes) noexcept {
+    auto _byte2 = static_cast<std::uint8_t>(stream & StreamFilter);
+    if (needReply && (function & 1u) != 0u) {
+      _byte2 |= WBitFlag;
+    }
+    return SECSMessageHeader(sessionId, _byte2, function, 0,
+                             SType::DataMessage, systemBytes);
+  }
+  static constexpr SECSMessageHeader Control(SType stype,
+                                             std::uint32_t systemBytes,
+                                             std::uint16_t sessionId = 0xFFFF,
+                                             std::uint8_t headerByte3 = 0) noexcept {
+    return SECSMessageHeader(sessionId, 0, headerByte3, 0, stype, systemBytes);
+  }
+  // Header of the reply to this data message: same session and system bytes,
+  // function + 1 (0 for an abort) and no W-bit.
+  constexpr SECSMessageHeader Reply(bool abort = false) const noexcept {
+    return SECSMessageHeader(
+        session_id_, static_cast<std::uint8_t>(header_byte2_ & StreamFilter),
+        static_cast<std::uint8_t>(abort ? 0u : header_byte3_ + 1u), ptype_,
+        stype_, system_bytes_);
+  }
+
+  constexpr std::uint16_t SessionId() const noexcept { return session_id_; }
+  constexpr std::uint8_t HeaderByte2() const noexcept { return header_byte2_; }
+  constexpr std::uint8_t HeaderByte3() const noexcept { return header_byte3_; }
+  constexpr std::uint8_t PType() const noexcept { return ptype_; }
+  constexpr SType GetSType() const noexcept { return stype_; }
+  constexpr std::uint32_t SystemBytes() const noexcept { return system_bytes_; }
+  constexpr bool IsData() const noexcept {
+    return stype_ == SType::DataMessage;
+  }
+  constexpr std::uint8_t Stream() const noexcept {
+    return static_cast<std::uint8_t>(header_byte2_ & StreamFilter);
+  }
+  constexpr std::uint8_t Function() const noexcept { return header_byte3_; }
+  constexpr bool NeedReply() const noexcept {
+    return (header_byte2_ & WBitFlag) != 0u;
+  }
+
+  constexpr void SetSessionId(std::uint16_t sessionId) noexcept {
+    session_id_ = sessionId;
+  }
+  constexpr void SetSystemBytes(std::uint32_t systemBytes) noexcept {
+    system_bytes_ = systemBytes;
+  }
+
+  // Writes the header into the first ten bytes of `bytes`.
+  constexpr void Pack(std::span<std::uint8_t, Size> bytes) const noexcept {
+    bytes[0] = static_cast<std::uint8_t>(session_id_ >> 8);
+    bytes[1] = static_cast<std::uint8_t>(session_id_);
+    bytes[2] = header_byte2_;
+    bytes[3] = header_byte3_;
+    bytes[4] = ptype_;
+    bytes[5] = static_cast<std::uint8_t>(stype_);
+    for (int i = 0; i < 4; i++) {
+      bytes[6 + i] =
+          static_cast<std::uint8_t>(system_bytes_ >> ((3 - i) << 3));
+    }
+  }
+  static constexpr SECSMessageHeader
+  Unpack(std::span<const std::uint8_t, Size> bytes) noexcept {
+    std::uint32_t _system = 0;
+    for (int i = 0; i < 4; i++) {
+      _system = (_system << 8) | bytes[6 + i];
+    }
+    return SECSMessageHeader(
+        static_cast<std::uint16_t>((bytes[0] << 8) | bytes[1]), bytes[2],
+        bytes[3], bytes[4], static_cast<SType>(bytes[5]), _system);
+  }
+  // Writes at the front of `bytes` and advances it past the header.
+  constexpr bool TryPack(std::span<std::uint8_t> &bytes) const noexcept {
+    if (bytes.size() < Size) {
+      return false;
+    }
+    Pack(bytes.first<Size>());
+    bytes = bytes.subspan(Size);
+    return true;
+  }
+  // Reads from the front of `bytes` and advances it past the header.
+  static constexpr bool TryUnpack(std::span<const std::uint8_t> &bytes,
+                                  SECSMessageHeader &header) noexcept {
+    if (bytes.size() < Size) {
+      return false;
+    }
+    header = Unpack(bytes.first<Size>());
+    bytes = bytes.subspan(Size);
+    return true;
+  }
+
+  constexpr bool operator==(const SECSMessageHeader &) const noexcept = default;
+};
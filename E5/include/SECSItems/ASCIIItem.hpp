@@ -2,33 +2,53 @@
 #include <SECSItem.hpp>
 #include <StringUtils.hpp>
 #include <string>
+#include <cstring>
 #include <string_view>
 
 class ASCIIItem : public SECSItem<ASCIIItem> {
 private:
-  std::string value_;
+  std::pmr::string value_;
 
 public:
-  FormatCode GetFormat() const noexcept { return FormatCode::ASCIIFormatCode; }
+  ASCIIItem() = default;
+  explicit ASCIIItem(std::pmr::memory_resource *resource) : value_(resource) {}
+  static constexpr FormatCode Code = FormatCode::ASCIIFormatCode;
+  FormatCode GetFormat() const noexcept { return Code; }
   std::string Value() const {
-    return value_;
+    return std::string(value_);
   }
+  std::string_view Text() const noexcept { return value_; }
+  // Writable view for in-place updates; Resize first to change the length.
+  std::span<char> MutableText() noexcept { return value_; }
+  void Resize(std::size_t count) { value_.resize(count); }
+  void Assign(std::string_view text) { value_.assign(text); }
   bool ParseContent(std::string_view _context) {
     value_ = StringUtils::trim(_context);
     return true;
   }
-  std::string DeparseContent([[maybe_unused]] int level) const {
-    return ' ' + value_;
+  void DeparseContent(std::string &builder, [[maybe_unused]] int level,
+                      [[maybe_unused]] bool compact) const {
+    builder += ' ';
+    builder += value_;
   }
   std::size_t Size() noexcept { return value_.size(); }
-  bool Serialize(std::vector<std::uint8_t> &bytes) const {
+  bool Serialize(std::span<std::uint8_t> &bytes) const noexcept {
     if (value_.empty()) {
       return true;
     }
-    bytes.reserve(bytes.size() + value_.size());
-    bytes.insert(bytes.end(), value_.begin(), value_.end());
+    std::memcpy(bytes.data(), value_.data(), value_.size());
+    bytes = bytes.subspan(value_.size());
     return true;
   }
+  std::size_t ElementWidth() const noexcept override { return 1; }
+  bool TryResizePayload(std::size_t length) override {
+    value_.resize(length);
+    return true;
+  }
+  void LoadElements(std::size_t index, const std::uint8_t *src,
+                    std::size_t count) noexcept override {
+    std::memcpy(value_.data() + index, src, count);
+  }
   bool Deserialize(std::span<std::uint8_t> &bytes, int length) {
     if (length < 0 || length > static_cast<int>(bytes.size())) {
       return false;
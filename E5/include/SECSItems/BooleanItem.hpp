@@ -1,11 +1,10 @@
 #pragma once
 #include <SECSItem.hpp>
 #include <bit>
+#include <cstring>
 
-class BooleanItem : public SECSItem<BooleanItem> {
+class BooleanItem : public SECSArrayItem<BooleanItem, char> {
 private:
-  using type = char;
-  std::vector<type> values;
   static constexpr std::uint8_t LogOfElemBytesCount =
       std::bit_width(sizeof(type)) - 1;
   static constexpr std::uint8_t ElemBytesCount = sizeof(type);
@@ -33,9 +32,11 @@ private:
   static constexpr std::uint8_t falseBytes = 0;
 
 public:
-  FormatCode GetFormat() const noexcept {
-    return FormatCode::BooleanFormatCode;
-  }
+  BooleanItem() = default;
+  explicit BooleanItem(std::pmr::memory_resource *resource)
+      : SECSArrayItem(resource) {}
+  static constexpr FormatCode Code = FormatCode::BooleanFormatCode;
+  FormatCode GetFormat() const noexcept { return Code; }
     type Value() const {
       if (values.empty()) {
         return type{};
@@ -44,41 +45,20 @@ public:
   }
   std::size_t Size() noexcept { return values.size() << LogOfElemBytesCount; }
   bool ParseContent(std::string_view _context) {
-    auto subStrings = StringUtils::SplitAndRemoveEmpty(_context);
-    values.clear();
-    values.reserve(subStrings.size());
-    for (const auto &sub : subStrings) {
-      type _value;
-      if (!ParseValue(sub, _value)) {
-        return false;
-      }
-      values.emplace_back(_value);
-    }
-    return true;
+    return StringUtils::ParseValues(_context, values, ParseValue);
   }
-  std::string DeparseContent([[maybe_unused]] int level) const {
-    if (values.empty()) {
-      return {};
-    }
-    std::string builder;
-    builder.reserve(values.size() * 7);
+  void DeparseContent(std::string &builder, [[maybe_unused]] int level,
+                      [[maybe_unused]] bool compact) const {
     for (const auto &_value : values) {
-      builder += ' ';
-      // builder += StringUtils::DeparseValue(static_cast<bool>(_value));
-      builder += (_value ? "true" : "false");
+      builder += (_value ? " true" : " false");
     }
-    return builder;
   }
-  bool Serialize(std::vector<std::uint8_t> &bytes) const {
-    try {
-      bytes.reserve(bytes.size() + values.size());
-      // for (const auto &_it : values) {
-      //     bytes.emplace_back(_it ? trueBytes : falseBytes);
-      // }
-      bytes.insert(bytes.end(), values.begin(), values.end());
-    } catch (...) {
-      return false;
+  bool Serialize(std::span<std::uint8_t> &bytes) const noexcept {
+    if (values.empty()) {
+      return true;
     }
+    std::memcpy(bytes.data(), values.data(), values.size());
+    bytes = bytes.subspan(values.size());
     return true;
   }
   bool Deserialize(std::span<std::uint8_t> &bytes, int length) {
@@ -1,63 +1,43 @@
 #pragma once
+#include <ByteOrder.hpp>
 #include <SECSItem.hpp>
 #include <bit>
 #include <cstring>
 
-class FloatItem : public SECSItem<FloatItem> {
+class FloatItem : public SECSArrayItem<FloatItem, float> {
 private:
-  using type = float;
-  std::vector<type> values;
   static constexpr std::uint8_t LogOfElemBytesCount =
       std::bit_width(sizeof(type)) - 1;
   static constexpr std::uint8_t ElemBytesCount = sizeof(type);
   static constexpr std::uint8_t SizeFilter = sizeof(type) - 1;
 
 public:
+  FloatItem() = default;
+  explicit FloatItem(std::pmr::memory_resource *resource)
+      : SECSArrayItem(resource) {}
   type Value() const {
       if (values.empty()) {
         return type{};
       }
     return values.front();
   }
-  FormatCode GetFormat() const noexcept { return FormatCode::FloatFormatCode; }
+  static constexpr FormatCode Code = FormatCode::FloatFormatCode;
+  FormatCode GetFormat() const noexcept { return Code; }
   std::size_t Size() noexcept { return values.size() << LogOfElemBytesCount; }
   bool ParseContent(std::string_view _context) noexcept {
-    auto subStrings = StringUtils::SplitAndRemoveEmpty(_context);
-    values.clear();
-    values.reserve(subStrings.size());
-    for (const auto &sub : subStrings) {
-      type _value;
-      if (!StringUtils::ParseValue<type>(sub, _value)) {
-        return false;
-      }
-      values.emplace_back(_value);
-    }
-    return true;
+    return StringUtils::ParseValues<type>(_context, values);
   }
-  std::string DeparseContent([[maybe_unused]] int level) const noexcept {
-    std::ostringstream builder;
+  void DeparseContent(std::string &builder, [[maybe_unused]] int level,
+                      [[maybe_unused]] bool compact,
+                      StringUtils::FloatFormat floatFormat) const {
     for (const auto &_value : values) {
-      builder << ' ' << StringUtils::DeparseValue(_value);
+      builder += ' ';
+      StringUtils::AppendValue(builder, _value, floatFormat);
     }
-    return builder.str();
   }
-  bool Serialize(std::vector<std::uint8_t> &bytes) const {
-    try {
-      size_t oldSize = bytes.size();
-      bytes.resize(oldSize + values.size() * sizeof(type));
-      for (size_t i = 0; i < values.size(); ++i) {
-        std::uint32_t u;
-        std::memcpy(&u, &values[i], sizeof(u));
-
-        size_t offset = oldSize + i * sizeof(type);
-        bytes[offset + 0] = static_cast<std::uint8_t>(u >> 24);
-        bytes[offset + 1] = static_cast<std::uint8_t>(u >> 16);
-        bytes[offset + 2] = static_cast<std::uint8_t>(u >> 8);
-        bytes[offset + 3] = static_cast<std::uint8_t>(u >> 0);
-      }
-    } catch (...) {
-      return false;
-    }
+  bool Serialize(std::span<std::uint8_t> &bytes) const noexcept {
+    ByteOrder::StoreBigEndian(bytes.data(), values.data(), values.size());
+    bytes = bytes.subspan(values.size() * ElemBytesCount);
     return true;
   }
   bool Deserialize(std::span<std::uint8_t> &bytes, int length) {
@@ -66,21 +46,8 @@ public:
         (length & SizeFilter) != 0) {
       return false;
     }
-    values.reserve(length / ElemBytesCount);
-    for (int i = 0; i < length; i += ElemBytesCount) {
-      try {
-        auto _byte = bytes.subspan(i, ElemBytesCount);
-        std::uint32_t _value = (static_cast<std::uint64_t>(_byte[0]) << 24) |
-                               (static_cast<std::uint64_t>(_byte[1]) << 16) |
-                               (static_cast<std::uint64_t>(_byte[2]) << 8) |
-                               _byte[3];
-        type _tmp = 0;
-        std::memcpy(&_tmp, &_value, sizeof(type));
-        values.emplace_back(_tmp);
-      } catch (...) {
-        return false;
-      }
-    }
+    values.resize(length / ElemBytesCount);
+    ByteOrder::LoadBigEndian(values.data(), bytes.data(), values.size());
     bytes = bytes.subspan(length);
     return true;
   }
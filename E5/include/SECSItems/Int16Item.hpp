@@ -1,65 +1,44 @@
 #pragma once
+#include <ByteOrder.hpp>
 #include <SECSItem.hpp>
 #include <bit>
 #include <cstdint>
 #include <cstring>
 
-class Int16Item : public SECSItem<Int16Item> {
+class Int16Item : public SECSArrayItem<Int16Item, std::int16_t> {
 private:
-  using type = std::int16_t;
-  std::vector<type> values;
   static constexpr std::uint8_t LogOfElemBytesCount =
       std::bit_width(sizeof(type)) - 1;
   static constexpr std::uint8_t ElemBytesCount = sizeof(type);
   static constexpr std::uint8_t SizeFilter = sizeof(type) - 1;
 
 public:
+  Int16Item() = default;
+  explicit Int16Item(std::pmr::memory_resource *resource)
+      : SECSArrayItem(resource) {}
   type Value() const {
       if (values.empty()) {
         return type{};
       }
     return values.front();
   }
-  FormatCode GetFormat() const noexcept { return FormatCode::Int16FormatCode; }
+  static constexpr FormatCode Code = FormatCode::Int16FormatCode;
+  FormatCode GetFormat() const noexcept { return Code; }
   std::size_t Size() noexcept { return values.size() << LogOfElemBytesCount; }
   bool ParseContent(std::string_view _context) {
-    auto subStrings = StringUtils::SplitAndRemoveEmpty(_context);
-    values.clear();
-    values.reserve(subStrings.size());
-    for (const auto &sub : subStrings) {
-      type _value;
-      if (!StringUtils::ParseValue<type>(sub, _value)) {
-        return false;
-      }
-      values.emplace_back(_value);
-    }
-    return true;
+    return StringUtils::ParseValues<type>(_context, values);
   }
 
-  std::string DeparseContent([[maybe_unused]] int level) const {
-    if (values.empty()) {
-      return {};
-    }
-    std::string builder;
-    builder.reserve(values.size() * 7);
+  void DeparseContent(std::string &builder, [[maybe_unused]] int level,
+                      [[maybe_unused]] bool compact) const {
     for (const auto &_value : values) {
       builder += ' ';
-      builder += StringUtils::DeparseValue(_value);
+      StringUtils::AppendValue(builder, _value);
     }
-    return builder;
   }
-  bool Serialize(std::vector<std::uint8_t> &bytes) const {
-    try {
-      std::size_t oldSize = bytes.size();
-      bytes.reserve(oldSize + values.size() * sizeof(type));
-      for (const auto &value : values) {
-        std::uint16_t u = static_cast<uint16_t>(value);
-        bytes.emplace_back(static_cast<std::uint8_t>(u >> 8));
-        bytes.emplace_back(static_cast<std::uint8_t>(u >> 0));
-      }
-    } catch (...) {
-      return false;
-    }
+  bool Serialize(std::span<std::uint8_t> &bytes) const noexcept {
+    ByteOrder::StoreBigEndian(bytes.data(), values.data(), values.size());
+    bytes = bytes.subspan(values.size() * ElemBytesCount);
     return true;
   }
   bool Deserialize(std::span<std::uint8_t> &bytes, int length) {
@@ -68,16 +47,8 @@ public:
         (length & SizeFilter) != 0) {
       return false;
     }
-    values.reserve(length / ElemBytesCount);
-    for (int i = 0; i < length; i += ElemBytesCount) {
-      try {
-        auto _bytes = bytes.subspan(i, ElemBytesCount);
-        type _value = (static_cast<type>(_bytes[0]) << 8) | _bytes[1];
-        values.emplace_back(_value);
-      } catch (...) {
-        return false;
-      }
-    }
+    values.resize(length / ElemBytesCount);
+    ByteOrder::LoadBigEndian(values.data(), bytes.data(), values.size());
     bytes = bytes.subspan(length);
     return true;
   }
@@ -1,67 +1,44 @@
 #pragma once
+#include <ByteOrder.hpp>
 #include <SECSItem.hpp>
 #include <bit>
 #include <cstdint>
 #include <cstring>
 
-class Int32Item : public SECSItem<Int32Item> {
+class Int32Item : public SECSArrayItem<Int32Item, std::int32_t> {
 private:
-  using type = std::int32_t;
-  std::vector<type> values;
   static constexpr std::uint8_t LogOfElemBytesCount =
       std::bit_width(sizeof(type)) - 1;
   static constexpr std::uint8_t ElemBytesCount = sizeof(type);
   static constexpr std::uint8_t SizeFilter = sizeof(type) - 1;
 
 public:
+  Int32Item() = default;
+  explicit Int32Item(std::pmr::memory_resource *resource)
+      : SECSArrayItem(resource) {}
   type Value() const {
       if (values.empty()) {
         return type{};
       }
     return values.front();
   }
-  FormatCode GetFormat() const noexcept { return FormatCode::Int32FormatCode; }
+  static constexpr FormatCode Code = FormatCode::Int32FormatCode;
+  FormatCode GetFormat() const noexcept { return Code; }
   std::size_t Size() noexcept { return values.size() << LogOfElemBytesCount; }
   bool ParseContent(std::string_view _context) {
-    auto subStrings = StringUtils::SplitAndRemoveEmpty(_context);
-    values.clear();
-    values.reserve(subStrings.size());
-    for (const auto &sub : subStrings) {
-      type _value;
-      if (!StringUtils::ParseValue<type>(sub, _value)) {
-        return false;
-      }
-      values.emplace_back(_value);
-    }
-    return true;
+    return StringUtils::ParseValues<type>(_context, values);
   }
 
-  std::string DeparseContent([[maybe_unused]] int level) const {
-    if (values.empty()) {
-      return {};
-    }
-    std::string builder;
-    builder.reserve(values.size() * 12);
+  void DeparseContent(std::string &builder, [[maybe_unused]] int level,
+                      [[maybe_unused]] bool compact) const {
     for (const auto &_value : values) {
       builder += ' ';
-      builder += StringUtils::DeparseValue(_value);
+      StringUtils::AppendValue(builder, _value);
     }
-    return builder;
   }
-  bool Serialize(std::vector<std::uint8_t> &bytes) const {
-    try {
-      std::size_t oldSize = bytes.size();
-      bytes.reserve(oldSize + values.size() * sizeof(type));
-      for (const auto &value : values) {
-        std::uint32_t u = static_cast<uint32_t>(value);
-        bytes.emplace_back(static_cast<std::uint8_t>(u >> 24));
-        bytes.emplace_back(static_cast<std::uint8_t>(u >> 16));
-        bytes.emplace_back(static_cast<std::uint8_t>(u >> 8));
-        bytes.emplace_back(static_cast<std::uint8_t>(u >> 0));
-      }
-    } catch (...) {
-      return false;
-    }
+  bool Serialize(std::span<std::uint8_t> &bytes) const noexcept {
+    ByteOrder::StoreBigEndian(bytes.data(), values.data(), values.size());
+    bytes = bytes.subspan(values.size() * ElemBytesCount);
     return true;
   }
   bool Deserialize(std::span<std::uint8_t> &bytes, int length) {
@@ -70,18 +47,8 @@ public:
         (length & SizeFilter) != 0) {
       return false;
     }
-    values.reserve(length / ElemBytesCount);
-    for (int i = 0; i < length; i += ElemBytesCount) {
-      try {
-        auto _bytes = bytes.subspan(i, ElemBytesCount);
-        type _value = (static_cast<type>(_bytes[0]) << 24) |
-                      (static_cast<type>(_bytes[1]) << 16) |
-                      (static_cast<type>(_bytes[2]) << 8) | _bytes[3];
-        values.emplace_back(_value);
-      } catch (...) {
-        return false;
-      }
-    }
+    values.resize(length / ElemBytesCount);
+    ByteOrder::LoadBigEndian(values.data(), bytes.data(), values.size());
     bytes = bytes.subspan(length);
     return true;
   }
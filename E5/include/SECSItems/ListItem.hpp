@@ -1,77 +1,178 @@
 #pragma once
 #include <SECSBase.hpp>
 #include <SECSItem.hpp>
+#include <SECSItemView.hpp>
 #include <SECSParser.hpp>
+#include <SMLParser.hpp>
+#include <algorithm>
 #include <cstddef>
+#include <cstring>
+#include <iterator>
 #include <memory>
 #include <vector>
 
+// In lazy mode (SECSParser::TryDeserializeLazy) the list keeps its own copy
+// of the encoded children and decodes them in the non-const accessors, so a
+// lazily decoded list must not be read from several threads until
+// TryMaterialize has succeeded; const members never decode and stay safe to
+// share.
 class ListItem : public SECSItem<ListItem> {
 private:
-  std::vector<std::unique_ptr<SECSItemBase>> valueItems;
+  std::pmr::vector<std::unique_ptr<SECSItemBase>> valueItems;
+  // Lazy mode: child i is still encoded in lazy_bytes_ between
+  // lazy_offsets_[i] and lazy_offsets_[i + 1] until its slot is filled.
+  std::pmr::vector<std::uint8_t> lazy_bytes_;
+  std::pmr::vector<std::uint32_t> lazy_offsets_;
+  std::size_t lazy_pending_ = 0;
+
+  std::span<const std::uint8_t> LazyBytes(std::size_t index) const noexcept {
+    return std::span<const std::uint8_t>(lazy_bytes_)
+        .subspan(lazy_offsets_[index],
+                 lazy_offsets_[index + 1] - lazy_offsets_[index]);
+  }
+  bool IsPending(std::size_t index) const noexcept {
+    return !valueItems[index] && index + 1 < lazy_offsets_.size();
+  }
 
 public:
   ListItem() = default;
-  ListItem(std::vector<std::unique_ptr<SECSItemBase>> value) :  valueItems(std::move(value)){
+  explicit ListItem(std::pmr::memory_resource *resource)
+      : valueItems(resource), lazy_bytes_(resource), lazy_offsets_(resource) {}
+  ListItem(std::vector<std::unique_ptr<SECSItemBase>> value) {
+    valueItems.reserve(value.size());
+    std::move(value.begin(), value.end(), std::back_inserter(valueItems));
   }
-  const std::vector<std::unique_ptr<SECSItemBase>>& Values() const {
+  // Decodes any children still pending from a lazy decode; false if one of
+  // them does not decode, leaving it pending.
+  bool TryMaterialize() {
+    for (std::size_t i = 0; lazy_pending_ != 0 && i < valueItems.size();
+         i++) {
+      if (!At(i)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  // All children. Children of a lazily decoded list stay null until
+  // TryMaterialize (or At) has decoded them.
+  const std::pmr::vector<std::unique_ptr<SECSItemBase>> &Values() const {
     return valueItems;
   }
-  FormatCode GetFormat() const noexcept { return FormatCode::ListFormatCode; }
+  // Child access that decodes only the requested child in lazy mode;
+  // nullptr if the index is out of range or the child does not decode.
+  SECSItemBase *At(std::size_t index) {
+    if (index >= valueItems.size()) {
+      return nullptr;
+    }
+    if (IsPending(index)) {
+      std::span<std::uint8_t> _bytes(lazy_bytes_.data() + lazy_offsets_[index],
+                                     LazyBytes(index).size());
+      std::optional<std::unique_ptr<SECSItemBase>> _item;
+      if (SECSParser::TryDeserializeLazy(_bytes, _item, Resource()) &&
+          _item.has_value()) {
+        valueItems[index] = std::move(_item.value());
+        --lazy_pending_;
+      }
+    }
+    return valueItems[index].get();
+  }
+  bool Materialized() const noexcept { return lazy_pending_ == 0; }
+  static constexpr FormatCode Code = FormatCode::ListFormatCode;
+  FormatCode GetFormat() const noexcept { return Code; }
   std::size_t Size() noexcept { return valueItems.size(); }
   std::size_t Count() const noexcept {return valueItems.size();}
-  bool ParseContent(std::string_view _context) {
+  void Append(std::unique_ptr<SECSItemBase> item) {
+    valueItems.emplace_back(std::move(item));
+  }
+  void Clear() noexcept {
     valueItems.clear();
-    if (_context.empty()) {
-      return true;
+    lazy_bytes_.clear();
+    lazy_offsets_.clear();
+    lazy_pending_ = 0;
+  }
+  bool ParseContent(std::string_view _context) {
+    return SMLParser::ParseItems(_context, *this);
+  }
+  // Fails if a pending child does not decode.
+  bool DeparseContent(std::string &builder, int level, bool compact,
+                      StringUtils::FloatFormat floatFormat) {
+    if (!TryMaterialize()) {
+      return false;
     }
-    const int _len = static_cast<int>(_context.size());
-    int count = 0, lastIndex = -1;
-    for (int i = 0; i < _len; i++) {
-      if (_context[i] == RangeStartMark) {
-        count += 1;
-      } else if (_context[i] == RangeEndMark) {
-        count -= 1;
-        if (count == 0) {
-          auto _item = SECSParser::TryParseContent(
-              _context.substr(lastIndex + 1, i - lastIndex));
-          if (!_item.has_value()) {
-            return false;
-          }
-          valueItems.emplace_back(std::move(_item.value()));
-          lastIndex = i;
-        }
-      } else if (count == 0 &&
-                 !std::isspace(static_cast<unsigned char>(_context[i]))) {
+    for (const auto &_subItem : valueItems) {
+      builder += compact ? ' ' : '\n';
+      if (!_subItem->TryDeparseContent(builder, level + 1, compact,
+                                       floatFormat)) {
         return false;
       }
     }
-    return count == 0;
+    if (!valueItems.empty() && !compact) {
+      builder += '\n';
+      builder += GetPrefix(level);
+    }
+    return true;
   }
-  std::string DeparseContent(int level) const {
-    std::ostringstream builder;
-    for (const auto &subItem : valueItems) {
-      builder << std::endl << subItem->TryDeparseContent(level + 1);
+  std::size_t EncodedPayloadSize() const noexcept {
+    std::size_t _total = 0;
+    for (std::size_t i = 0; i < valueItems.size(); i++) {
+      if (IsPending(i)) {
+        _total += LazyBytes(i).size();
+        continue;
+      }
+      auto _size = valueItems[i]->EncodedSize();
+      if (_size == std::numeric_limits<std::size_t>::max()) {
+        return _size;
+      }
+      _total += _size;
     }
-    if (!valueItems.empty()) {
-      builder << std::endl << GetPrefix(level);
+    return _total;
+  }
+  // Undecoded children are hashed from their original bytes.
+  void HashPayload(SECSHasher &hasher) const {
+    for (std::size_t i = 0; i < valueItems.size(); i++) {
+      if (IsPending(i)) {
+        hasher.UpdateEncoded(LazyBytes(i));
+        continue;
+      }
+      valueItems[i]->TryHash(hasher);
     }
-    return builder.str();
   }
-  bool Serialize(std::vector<std::uint8_t> &bytes) const {
-    for (const auto &_subItem : valueItems) {
-      if (!_subItem->TrySerialize(bytes)) {
+  bool EqualsPayload(ListItem &other) {
+    if (valueItems.size() != other.valueItems.size()) {
+      return false;
+    }
+    for (std::size_t i = 0; i < valueItems.size(); i++) {
+      auto _lhs = At(i), _rhs = other.At(i);
+      if (!_lhs || !_rhs || !_lhs->TryEquals(*_rhs)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  // Undecoded children are copied through as their original bytes.
+  bool Serialize(std::span<std::uint8_t> &bytes) const {
+    for (std::size_t i = 0; i < valueItems.size(); i++) {
+      if (IsPending(i)) {
+        auto _raw = LazyBytes(i);
+        if (bytes.size() < _raw.size()) {
+          return false;
+        }
+        std::memcpy(bytes.data(), _raw.data(), _raw.size());
+        bytes = bytes.subspan(_raw.size());
+        continue;
+      }
+      if (!valueItems[i]->TrySerialize(bytes)) {
         return false;
       }
     }
     return true;
   }
   bool Deserialize(std::span<std::uint8_t> &bytes, int length) {
-    valueItems.clear();
+    Clear();
     valueItems.reserve(length);
     for (int i = 0; i < length; i++) {
       std::optional<std::unique_ptr<SECSItemBase>> _subItem;
-      auto _result = SECSParser::TryDeserialize(bytes, _subItem);
+      auto _result = SECSParser::TryDeserialize(bytes, _subItem, Resource());
       if (!_result || !_subItem.has_value()) {
         return false;
       }
@@ -79,4 +180,38 @@ public:
     }
     return true;
   }
+  // Skip-scans (and validates) the children, recording their offsets and
+  // copying their encoded bytes, so `bytes` may be reused once this returns.
+  bool DeserializeLazy(std::span<std::uint8_t> &bytes, int length) {
+    Clear();
+    if (length < 0) {
+      return false;
+    }
+    try {
+      // each child takes at least two bytes, so cap what a bogus length
+      // reserves
+      lazy_offsets_.reserve(
+          std::min<std::size_t>(length, bytes.size() >> 1) + 1);
+      lazy_offsets_.push_back(0);
+      std::span<const std::uint8_t> _rest = bytes;
+      for (int i = 0; i < length; i++) {
+        SECSItemView _child;
+        if (!SECSItemView::TryParse(_rest, _child)) {
+          Clear();
+          return false;
+        }
+        lazy_offsets_.push_back(
+            static_cast<std::uint32_t>(bytes.size() - _rest.size()));
+      }
+      auto _used = bytes.size() - _rest.size();
+      lazy_bytes_.assign(bytes.begin(), bytes.begin() + _used);
+      valueItems.resize(length);
+      bytes = bytes.subspan(_used);
+    } catch (...) {
+      Clear();
+      return false;
+    }
+    lazy_pending_ = length;
+    return true;
+  }
 };
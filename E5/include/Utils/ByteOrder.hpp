@@ -0,0 +1,98 @@
+#pragma once
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+class ByteOrder {
+private:
+  // Below this many elements the dispatch call costs more than it saves.
+  static constexpr std::size_t BulkThreshold = 8;
+
+public:
+  // Copies `count` elements of `Width` bytes reversing the bytes of each one.
+  // Uses AVX2 or SSSE3 shuffles when the CPU has them, chosen once at runtime.
+  template <std::size_t Width>
+  static void SwapCopy(std::uint8_t *dst, const std::uint8_t *src,
+                       std::size_t count) noexcept;
+
+  template <typename T>
+  using raw_type = std::conditional_t<
+      sizeof(T) == 1, std::uint8_t,
+      std::conditional_t<
+          sizeof(T) == 2, std::uint16_t,
+          std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>>>;
+
+  template <typename T>
+  [[nodiscard]]
+  static inline T LoadBigEndian(const std::uint8_t *src) noexcept {
+    static_assert(std::is_arithmetic_v<T>, "Only for arithmetic types");
+    if constexpr (std::is_same_v<T, bool>) {
+      return *src != 0;
+    } else {
+      raw_type<T> raw;
+      std::memcpy(&raw, src, sizeof(T));
+      if constexpr (std::endian::native == std::endian::little &&
+                    sizeof(T) > 1) {
+        raw = std::byteswap(raw);
+      }
+      return std::bit_cast<T>(raw);
+    }
+  }
+  template <typename T>
+  static inline void StoreBigEndian(std::uint8_t *dst, T value) noexcept {
+    static_assert(std::is_arithmetic_v<T>, "Only for arithmetic types");
+    if constexpr (std::is_same_v<T, bool>) {
+      *dst = value ? 1 : 0;
+    } else {
+      auto raw = std::bit_cast<raw_type<T>>(value);
+      if constexpr (std::endian::native == std::endian::little &&
+                    sizeof(T) > 1) {
+        raw = std::byteswap(raw);
+      }
+      std::memcpy(dst, &raw, sizeof(T));
+    }
+  }
+  template <typename T>
+  static inline void LoadBigEndian(T *dst, const std::uint8_t *src,
+                                   std::size_t count) noexcept {
+    static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>,
+                  "Only for arithmetic types");
+    if (count == 0) {
+      return;
+    }
+    if constexpr (sizeof(T) == 1 || std::endian::native == std::endian::big) {
+      std::memcpy(dst, src, count * sizeof(T));
+    } else {
+      if (count < BulkThreshold) {
+        for (std::size_t i = 0; i < count; i++) {
+          dst[i] = LoadBigEndian<T>(src + i * sizeof(T));
+        }
+        return;
+      }
+      SwapCopy<sizeof(T)>(reinterpret_cast<std::uint8_t *>(dst), src, count);
+    }
+  }
+  template <typename T>
+  static inline void StoreBigEndian(std::uint8_t *dst, const T *src,
+                                    std::size_t count) noexcept {
+    static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>,
+                  "Only for arithmetic types");
+    if (count == 0) {
+      return;
+    }
+    if constexpr (sizeof(T) == 1 || std::endian::native == std::endian::big) {
+      std::memcpy(dst, src, count * sizeof(T));
+    } else {
+      if (count < BulkThreshold) {
+        for (std::size_t i = 0; i < count; i++) {
+          StoreBigEndian(dst + i * sizeof(T), src[i]);
+        }
+        return;
+      }
+      SwapCopy<sizeof(T)>(dst, reinterpret_cast<const std::uint8_t *>(src),
+                          count);
+    }
+  }
+};
@@ -0,0 +1,162 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+
+// Vector-like storage for trivially copyable elements that keeps up to
+// InlineBytes worth of them inside the object and only spills larger runs
+// to its memory_resource. Grows geometrically once spilled.
+template <typename T, std::size_t InlineBytes = 16> class SmallBuffer {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "SmallBuffer only holds trivially copyable types");
+
+public:
+  static constexpr std::size_t InlineCount =
+      std::max<std::size_t>(1, InlineBytes / sizeof(T));
+  using value_type = T;
+  using size_type = std::size_t;
+  using iterator = T *;
+  using const_iterator = const T *;
+
+private:
+  alignas(T) std::byte inline_[InlineCount * sizeof(T)];
+  T *data_ = reinterpret_cast<T *>(inline_);
+  std::size_t size_ = 0;
+  std::size_t capacity_ = InlineCount;
+  std::pmr::memory_resource *resource_;
+
+  bool IsInline() const noexcept {
+    return data_ == reinterpret_cast<const T *>(inline_);
+  }
+  void Release() noexcept {
+    if (!IsInline()) {
+      resource_->deallocate(data_, capacity_ * sizeof(T), alignof(T));
+      data_ = reinterpret_cast<T *>(inline_);
+      capacity_ = InlineCount;
+    }
+  }
+  void Grow(std::size_t count) {
+    auto _capacity = std::max(count, capacity_ * 2);
+    auto _data = static_cast<T *>(
+        resource_->allocate(_capacity * sizeof(T), alignof(T)));
+    if (size_ != 0) {
+      std::memcpy(_data, data_, size_ * sizeof(T));
+    }
+    Release();
+    data_ = _data;
+    capacity_ = _capacity;
+  }
+
+public:
+  SmallBuffer() noexcept : resource_(std::pmr::get_default_resource()) {}
+  explicit SmallBuffer(std::pmr::memory_resource *resource) noexcept
+      : resource_(resource ? resource : std::pmr::get_default_resource()) {}
+  SmallBuffer(const SmallBuffer &obj) : resource_(obj.resource_) {
+    assign(obj.begin(), obj.end());
+  }
+  // Never allocates: inline elements are copied and a spilled block is
+  // taken over along with its resource.
+  SmallBuffer(SmallBuffer &&obj) noexcept : resource_(obj.resource_) {
+    if (obj.IsInline()) {
+      if (obj.size_ != 0) {
+        std::memcpy(inline_, obj.inline_, obj.size_ * sizeof(T));
+      }
+    } else {
+      data_ = obj.data_;
+      capacity_ = obj.capacity_;
+      obj.data_ = reinterpret_cast<T *>(obj.inline_);
+      obj.capacity_ = InlineCount;
+    }
+    size_ = obj.size_;
+    obj.size_ = 0;
+  }
+  SmallBuffer &operator=(const SmallBuffer &obj) {
+    if (this != &obj) {
+      assign(obj.begin(), obj.end());
+    }
+    return *this;
+  }
+  // Steals a spilled block when both sides share a resource. Otherwise the
+  // elements are copied, which only allocates (and so may throw) when a
+  // spilled block moves between resources.
+  SmallBuffer &operator=(SmallBuffer &&obj) {
+    if (this == &obj) {
+      return *this;
+    }
+    if (obj.IsInline() || *resource_ != *obj.resource_) {
+      assign(obj.begin(), obj.end());
+      obj.clear();
+      return *this;
+    }
+    Release();
+    data_ = obj.data_;
+    size_ = obj.size_;
+    capacity_ = obj.capacity_;
+    obj.data_ = reinterpret_cast<T *>(obj.inline_);
+    obj.size_ = 0;
+    obj.capacity_ = InlineCount;
+    return *this;
+  }
+  ~SmallBuffer() { Release(); }
+
+  T *data() noexcept { return data_; }
+  const T *data() const noexcept { return data_; }
+  std::size_t size() const noexcept { return size_; }
+  std::size_t capacity() const noexcept { return capacity_; }
+  bool empty() const noexcept { return size_ == 0; }
+  T &front() noexcept { return data_[0]; }
+  const T &front() const noexcept { return data_[0]; }
+  T &operator[](std::size_t index) noexcept { return data_[index]; }
+  const T &operator[](std::size_t index) const noexcept {
+    return data_[index];
+  }
+  iterator begin() noexcept { return data_; }
+  iterator end() noexcept { return data_ + size_; }
+  const_iterator begin() const noexcept { return data_; }
+  const_iterator end() const noexcept { return data_ + size_; }
+
+  void clear() noexcept { size_ = 0; }
+  void reserve(std::size_t count) {
+    if (count > capacity_) {
+      Grow(count);
+    }
+  }
+  // New elements are value-initialized, as with std::vector.
+  void resize(std::size_t count) {
+    reserve(count);
+    if (count > size_) {
+      std::fill(data_ + size_, data_ + count, T{});
+    }
+    size_ = count;
+  }
+  template <typename... Args> T &emplace_back(Args &&...args) {
+    if (size_ == capacity_) {
+      Grow(size_ + 1);
+    }
+    data_[size_] = T(std::forward<Args>(args)...);
+    return data_[size_++];
+  }
+  template <std::input_iterator It> void assign(It first, It last) {
+    clear();
+    if constexpr (std::contiguous_iterator<It> &&
+                  std::is_same_v<std::iter_value_t<It>, T>) {
+      auto _count = static_cast<std::size_t>(last - first);
+      reserve(_count);
+      if (_count != 0) {
+        std::memmove(data_, std::to_address(first), _count * sizeof(T));
+      }
+      size_ = _count;
+    } else {
+      if constexpr (std::forward_iterator<It>) {
+        reserve(static_cast<std::size_t>(std::distance(first, last)));
+      }
+      for (; first != last; ++first) {
+        emplace_back(static_cast<T>(*first));
+      }
+    }
+  }
+};
@@ -1,10 +1,11 @@
 #pragma once
 #include <array>
 #include <cctype>
-#include <cerrno>
 #include <charconv>
 #include <cstdio>
+#include <iterator>
 #include <limits>
+#include <ranges>
 #include <string>
 #include <string_view>
 #include <system_error>
@@ -13,6 +14,15 @@
 
 class StringUtils {
 public:
+  // How floating point values are written to SML.
+  enum class FloatFormat {
+    // Fixed notation with six decimals; the historical output.
+    Fixed,
+    // Fewest digits that parse back to the same value, in fixed or
+    // scientific notation, whichever is shorter.
+    Shortest,
+  };
+
   static inline constexpr std::array<bool, 256> CreateSplitterLookup() {
     std::array<bool, 256> lookUP{};
     constexpr const char *ValuesSpliters = " \a\b\f\t\v\n\r";
@@ -55,6 +65,93 @@ public:
     }
     return result;
   }
+  // First splitter in [first, last), or `last`.
+  [[nodiscard]]
+  static const char *FindSplitter(const char *first, const char *last) noexcept;
+  // First non-splitter in [first, last), or `last`.
+  [[nodiscard]]
+  static const char *SkipSplitters(const char *first,
+                                   const char *last) noexcept;
+  // Number of tokens Tokenize(str) yields, counted sixteen bytes at a time.
+  [[nodiscard]]
+  static std::size_t CountTokens(std::string_view str) noexcept;
+
+  // Lazy view of the splitter separated tokens of a string; nothing is
+  // allocated and each token is located only when the iterator reaches it.
+  class TokenRange : public std::ranges::view_interface<TokenRange> {
+  private:
+    std::string_view str_;
+
+  public:
+    class iterator {
+    private:
+      const char *first_ = nullptr;
+      const char *last_ = nullptr;
+      const char *end_ = nullptr;
+
+    public:
+      using iterator_concept = std::forward_iterator_tag;
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = std::string_view;
+      using difference_type = std::ptrdiff_t;
+
+      iterator() = default;
+      iterator(const char *first, const char *end) noexcept
+          : first_(SkipSplitters(first, end)), end_(end) {
+        last_ = FindSplitter(first_, end_);
+      }
+      std::string_view operator*() const noexcept {
+        return std::string_view(first_, static_cast<std::size_t>(last_ - first_));
+      }
+      iterator &operator++() noexcept {
+        first_ = SkipSplitters(last_, end_);
+        last_ = FindSplitter(first_, end_);
+        return *this;
+      }
+      iterator operator++(int) noexcept {
+        auto _tmp = *this;
+        ++*this;
+        return _tmp;
+      }
+      bool operator==(const iterator &obj) const noexcept {
+        return first_ == obj.first_;
+      }
+      bool operator==(std::default_sentinel_t) const noexcept {
+        return first_ == end_;
+      }
+    };
+
+    TokenRange() = default;
+    explicit TokenRange(std::string_view str) noexcept : str_(str) {}
+    iterator begin() const noexcept {
+      return iterator(str_.data(), str_.data() + str_.size());
+    }
+    std::default_sentinel_t end() const noexcept { return {}; }
+  };
+  [[nodiscard]]
+  static TokenRange Tokenize(std::string_view str) noexcept {
+    return TokenRange(str);
+  }
+  // Parses every token of `str` into `values`, which is sized once from
+  // CountTokens; `parse(token, value)` converts a single token.
+  template <typename Container, typename Parser>
+  static bool ParseValues(std::string_view str, Container &values,
+                          Parser &&parse) {
+    values.resize(CountTokens(str));
+    auto _dst = values.data();
+    for (auto token : Tokenize(str)) {
+      if (!parse(token, *_dst++)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  template <typename T, typename Container>
+  static bool ParseValues(std::string_view str, Container &values) {
+    return ParseValues(str, values, [](std::string_view token, T &value) {
+      return ParseValue<T>(token, value);
+    });
+  }
   [[nodiscard]]
   static inline std::string_view trim(std::string_view str) noexcept {
     // std::string_view trimSpliters = " \t\n\r\f\v";
@@ -106,42 +203,98 @@ public:
     if (str.empty()) {
       return false;
     }
+    auto _first = str.data();
+    auto _last = _first + str.size();
     if constexpr (std::is_floating_point_v<T>) {
-      char *end;
-      errno = 0;
-      std::string raw{str};
-      if constexpr (std::is_same_v<T, float>) {
-        result = std::strtof(raw.c_str(), &end);
-      } else if (std::is_same_v<T, double>) {
-        result = std::strtod(raw.c_str(), &end);
-      } else {
-        return false;
+      // strtod accepted an explicit plus sign, from_chars does not
+      if (*_first == '+' && str.size() > 1 && _first[1] != '-') {
+        ++_first;
       }
-      return (end == raw.c_str() + raw.size()) && errno != EAGAIN;
-    } else {
-      auto _first = str.data();
-      auto _last = _first + str.size();
-      auto [ptr, err] = std::from_chars(_first, _last, result);
-      return err == std::errc{} && ptr == _last;
     }
-    return false;
+    auto [ptr, err] = std::from_chars(_first, _last, result);
+    return err == std::errc{} && ptr == _last;
   }
   template <typename T>
   [[nodiscard]]
-  static std::string DeparseValue(T value) {
+  static std::string
+  DeparseValue(T value, [[maybe_unused]] FloatFormat format = FloatFormat::Fixed) {
     if constexpr (std::is_same_v<T, bool>) {
       return value ? "true" : "false";
     } else if constexpr (std::is_integral_v<T>) {
       return DeparseIntegral(value);
     } else if constexpr (std::is_floating_point_v<T>) {
+      if (format == FloatFormat::Shortest) {
+        std::string builder;
+        AppendShortest(builder, value);
+        return builder;
+      }
       return DeparseFloating(value);
     } else {
       static_assert(std::is_arithmetic_v<T>,
                     "Unsupported type for DeparseValue");
     }
   }
+  // Writes the same text as DeparseValue straight into `builder`. `format`
+  // only applies to floating point values.
+  template <typename T>
+  static void AppendValue(std::string &builder, T value,
+                          [[maybe_unused]] FloatFormat format =
+                              FloatFormat::Fixed) {
+    if constexpr (std::is_same_v<T, bool>) {
+      builder += value ? "true" : "false";
+    } else if constexpr (std::is_integral_v<T>) {
+      AppendIntegral(builder, value);
+    } else if constexpr (std::is_floating_point_v<T>) {
+      if (format == FloatFormat::Shortest) {
+        AppendShortest(builder, value);
+      } else {
+        AppendFloating(builder, value);
+      }
+    } else {
+      static_assert(std::is_arithmetic_v<T>,
+                    "Unsupported type for AppendValue");
+    }
+  }
 
 private:
+  template <typename T>
+  static void AppendIntegral(std::string &builder, T value) {
+    static_assert(std::is_integral_v<T> && !std::is_same_v<T, bool>,
+                  "Only supports integral types");
+    std::array<char, std::numeric_limits<T>::digits10 + 3> buffer;
+    auto result =
+        std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+    builder.append(buffer.data(), result.ptr);
+  }
+  // Formats straight into the tail of `builder`; no temporary string.
+  template <typename T>
+  static void AppendShortest(std::string &builder, T value) {
+    static_assert(std::is_floating_point_v<T>, "Only for floating points");
+    // sign, max_digits10 digits, point and a signed three digit exponent
+    constexpr std::size_t _capacity = std::numeric_limits<T>::max_digits10 + 8;
+    auto oldSize = builder.size();
+    builder.resize(oldSize + _capacity);
+    auto _first = builder.data() + oldSize;
+    auto result = std::to_chars(_first, _first + _capacity, value);
+    builder.resize(result.ec == std::errc{}
+                       ? static_cast<std::size_t>(result.ptr - builder.data())
+                       : oldSize);
+  }
+  template <typename T>
+  static void AppendFloating(std::string &builder, T value,
+                             int Precision = 6) {
+    static_assert(std::is_floating_point_v<T>, "Only for floating points");
+    // wide enough for the largest finite value in fixed notation
+    std::array<char, std::numeric_limits<T>::max_exponent10 + 32> buffer;
+    std::to_chars_result result =
+        std::to_chars(buffer.data(), buffer.data() + buffer.size(), value,
+                      std::chars_format::fixed, Precision);
+    if (result.ec == std::errc{}) {
+      builder.append(buffer.data(), result.ptr);
+      return;
+    }
+    builder += std::to_string(value);
+  }
   template <typename T>
   [[nodiscard]]
   static std::string DeparseIntegral(T value) {
@@ -17,35 +17,40 @@
 #include <memory>
 
 std::unique_ptr<SECSItemBase> SECSFactory::createItem(FormatCode _code) {
+  return createItem(_code, nullptr);
+}
+
+std::unique_ptr<SECSItemBase>
+SECSFactory::createItem(FormatCode _code, std::pmr::memory_resource *resource) {
   switch (_code) {
   case FormatCode::ASCIIFormatCode:
-    return std::make_unique<ASCIIItem>();
+    return emplaceItem<ASCIIItem>(resource);
   case FormatCode::ListFormatCode:
-    return std::make_unique<ListItem>();
+    return emplaceItem<ListItem>(resource);
   case FormatCode::BinaryFormatCode:
-    return std::make_unique<BinaryItem>();
+    return emplaceItem<BinaryItem>(resource);
   case FormatCode::BooleanFormatCode:
-    return std::make_unique<BooleanItem>();
+    return emplaceItem<BooleanItem>(resource);
   case FormatCode::Int64FormatCode:
-    return std::make_unique<Int64Item>();
+    return emplaceItem<Int64Item>(resource);
   case FormatCode::Int8FormatCode:
-    return std::make_unique<Int8Item>();
+    return emplaceItem<Int8Item>(resource);
   case FormatCode::Int16FormatCode:
-    return std::make_unique<Int16Item>();
+    return emplaceItem<Int16Item>(resource);
   case FormatCode::Int32FormatCode:
-    return std::make_unique<Int32Item>();
+    return emplaceItem<Int32Item>(resource);
   case FormatCode::DoubleFormatCode:
-    return std::make_unique<DoubleItem>();
+    return emplaceItem<DoubleItem>(resource);
   case FormatCode::FloatFormatCode:
-    return std::make_unique<FloatItem>();
+    return emplaceItem<FloatItem>(resource);
   case FormatCode::UInt64FormatCode:
-    return std::make_unique<UInt64Item>();
+    return emplaceItem<UInt64Item>(resource);
   case FormatCode::UInt8FormatCode:
-    return std::make_unique<UInt8Item>();
+    return emplaceItem<UInt8Item>(resource);
   case FormatCode::UInt32FormatCode:
-    return std::make_unique<UInt32Item>();
+    return emplaceItem<UInt32Item>(resource);
   case FormatCode::UInt16FormatCode:
-    return std::make_unique<UInt16Item>();
+    return emplaceItem<UInt16Item>(resource);
   case FormatCode::None:
     return nullptr;
   default:
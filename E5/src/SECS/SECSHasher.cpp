@@ -0,0 +1,91 @@
+#include "SECSHasher.hpp"
+#include "SECSBase.hpp"
+#include "SECSItemView.hpp"
+
+void SECSItemBase::TryHash(SECSHasher &hasher) {
+  hasher.Header(FormatCode::None, 0);
+}
+
+bool SECSHasher::UpdateEncoded(std::span<const std::uint8_t> bytes) noexcept {
+  SECSItemView _root;
+  if (!SECSItemView::TryParse(bytes, _root)) {
+    return false;
+  }
+  auto _input = _root.Bytes();
+  std::size_t _offset = 0, _pending = 1;
+  while (_pending > 0) {
+    --_pending;
+    FormatCode format;
+    std::uint32_t length;
+    std::uint8_t headerSize;
+    SECSItemView::ReadHeader(_input.subspan(_offset), format, length,
+                             headerSize);
+    _offset += headerSize;
+    Header(format, length);
+    if (format == FormatCode::ListFormatCode) {
+      _pending += length;
+    } else {
+      Update(_input.data() + _offset, length);
+      _offset += length;
+    }
+  }
+  return true;
+}
+
+std::uint64_t SECSHasher::Hash(SECSItemBase &item, std::uint64_t seed) {
+  SECSHasher _hasher(seed);
+  item.TryHash(_hasher);
+  return _hasher.Finish();
+}
+
+bool SECSHasher::TryHash(std::span<const std::uint8_t> bytes,
+                         std::uint64_t &hash, std::uint64_t seed) noexcept {
+  SECSHasher _hasher(seed);
+  SECSItemView _root;
+  auto _rest = bytes;
+  if (!SECSItemView::TryParse(_rest, _root) || !_rest.empty() ||
+      !_hasher.UpdateEncoded(bytes)) {
+    return false;
+  }
+  hash = _hasher.Finish();
+  return true;
+}
+
+bool SECSHasher::Equals(SECSItemBase &lhs, SECSItemBase &rhs) {
+  return &lhs == &rhs || lhs.TryEquals(rhs);
+}
+
+bool SECSHasher::Equals(std::span<const std::uint8_t> lhs,
+                        std::span<const std::uint8_t> rhs) noexcept {
+  SECSItemView _lhs, _rhs;
+  if (!SECSItemView::TryParse(lhs, _lhs) || !lhs.empty() ||
+      !SECSItemView::TryParse(rhs, _rhs) || !rhs.empty()) {
+    return false;
+  }
+  auto _a = _lhs.Bytes(), _b = _rhs.Bytes();
+  std::size_t _offsetA = 0, _offsetB = 0, _pending = 1;
+  while (_pending > 0) {
+    --_pending;
+    FormatCode formatA, formatB;
+    std::uint32_t lengthA, lengthB;
+    std::uint8_t headerA, headerB;
+    SECSItemView::ReadHeader(_a.subspan(_offsetA), formatA, lengthA, headerA);
+    SECSItemView::ReadHeader(_b.subspan(_offsetB), formatB, lengthB, headerB);
+    if (formatA != formatB || lengthA != lengthB) {
+      return false;
+    }
+    _offsetA += headerA;
+    _offsetB += headerB;
+    if (formatA == FormatCode::ListFormatCode) {
+      _pending += lengthA;
+      continue;
+    }
+    if (lengthA != 0 &&
+        std::memcmp(_a.data() + _offsetA, _b.data() + _offsetB, lengthA) != 0) {
+      return false;
+    }
+    _offsetA += lengthA;
+    _offsetB += lengthB;
+  }
+  return true;
+}
@@ -0,0 +1,155 @@
+#include "SECSItemPool.hpp"
+#include <array>
+#include <new>
+
+namespace {
+
+class PoolTagResource final : public std::pmr::memory_resource {
+  void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+  void do_deallocate(void *p, std::size_t bytes,
+                     std::size_t alignment) override {
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+  }
+  bool do_is_equal(const std::pmr::memory_resource &obj) const noexcept override {
+    return this == &obj;
+  }
+};
+
+PoolTagResource tagResource;
+
+// Format codes are six-bit type codes shifted left by two.
+constexpr std::size_t FormatSlots = 64;
+
+struct FreeBlock {
+  FreeBlock *next;
+};
+
+struct FreeList {
+  FreeBlock *head = nullptr;
+  std::size_t size = 0;
+  SECSPoolStatistics stats;
+};
+
+// Set once the calling thread's pool is destroyed. Being trivially
+// destructible it stays readable for the rest of thread teardown, so nodes
+// released by thread_locals destroyed after the pool bypass it.
+thread_local bool poolDestroyed = false;
+
+struct ThreadPool {
+  std::array<FreeList, FormatSlots> lists;
+  std::size_t capacity = SECSItemPool::DefaultCapacity;
+
+  void Trim() noexcept {
+    for (auto &list : lists) {
+      while (list.head) {
+        auto _block = list.head;
+        list.head = _block->next;
+        ::operator delete(_block);
+      }
+      list.size = 0;
+      list.stats.cached = 0;
+    }
+  }
+  ~ThreadPool() {
+    Trim();
+    poolDestroyed = true;
+  }
+};
+
+// nullptr once the calling thread's pool has been destroyed
+ThreadPool *LocalPool() noexcept {
+  if (poolDestroyed) {
+    return nullptr;
+  }
+  thread_local ThreadPool pool;
+  return &pool;
+}
+
+std::size_t BlockSize(std::size_t size) noexcept {
+  return size < sizeof(FreeBlock) ? sizeof(FreeBlock) : size;
+}
+
+std::size_t Slot(FormatCode code) noexcept {
+  return (static_cast<std::size_t>(code) >> 2) & (FormatSlots - 1);
+}
+
+} // namespace
+
+std::pmr::memory_resource *SECSItemPool::Resource() noexcept {
+  return &tagResource;
+}
+
+// Every block of one slot holds the same item type, so sizes always match.
+void *SECSItemPool::Acquire(FormatCode code, std::size_t size) {
+  auto _pool = LocalPool();
+  if (!_pool) {
+    return ::operator new(BlockSize(size));
+  }
+  auto &list = _pool->lists[Slot(code)];
+  if (list.head) {
+    auto _block = list.head;
+    list.head = _block->next;
+    --list.size;
+    --list.stats.cached;
+    ++list.stats.reused;
+    return _block;
+  }
+  auto _block = ::operator new(BlockSize(size));
+  ++list.stats.allocated;
+  return _block;
+}
+
+void SECSItemPool::Release(FormatCode code, void *block,
+                           [[maybe_unused]] std::size_t size) noexcept {
+  auto _pool = LocalPool();
+  if (!_pool) {
+    ::operator delete(block);
+    return;
+  }
+  auto &list = _pool->lists[Slot(code)];
+  if (list.size >= _pool->capacity) {
+    ++list.stats.dropped;
+    ::operator delete(block);
+    return;
+  }
+  auto _block = ::new (block) FreeBlock{list.head};
+  list.head = _block;
+  ++list.size;
+  ++list.stats.cached;
+  ++list.stats.recycled;
+}
+
+SECSPoolStatistics SECSItemPool::Statistics(FormatCode code) noexcept {
+  auto _pool = LocalPool();
+  return _pool ? _pool->lists[Slot(code)].stats : SECSPoolStatistics{};
+}
+
+SECSPoolStatistics SECSItemPool::Statistics() noexcept {
+  SECSPoolStatistics _total;
+  auto _pool = LocalPool();
+  if (!_pool) {
+    return _total;
+  }
+  for (const auto &list : _pool->lists) {
+    _total.reused += list.stats.reused;
+    _total.allocated += list.stats.allocated;
+    _total.recycled += list.stats.recycled;
+    _total.dropped += list.stats.dropped;
+    _total.cached += list.stats.cached;
+  }
+  return _total;
+}
+
+void SECSItemPool::SetCapacity(std::size_t capacity) noexcept {
+  if (auto _pool = LocalPool()) {
+    _pool->capacity = capacity;
+  }
+}
+
+void SECSItemPool::Trim() noexcept {
+  if (auto _pool = LocalPool()) {
+    _pool->Trim();
+  }
+}
@@ -0,0 +1,111 @@
+#include "SECSMessage.hpp"
+#include "SECSParser.hpp"
+#include <cstring>
+#include <limits>
+
+SECSMessage::SECSMessage(std::uint16_t sessionId, const SECSHead &head,
+                         std::uint32_t systemBytes,
+                         std::unique_ptr<SECSItemBase> item) noexcept
+    : header_(sessionId, head.StreamByte(), head.FunctionByte(), 0,
+              SECSMessageHeader::SType::DataMessage, systemBytes),
+      item_(std::move(item)) {}
+
+void SECSMessage::SetItem(std::unique_ptr<SECSItemBase> item) noexcept {
+  item_ = std::move(item);
+  body_.clear();
+}
+
+void SECSMessage::SetBody(std::vector<std::uint8_t> body) noexcept {
+  item_.reset();
+  body_ = std::move(body);
+}
+
+std::unique_ptr<SECSItemBase> SECSMessage::TakeItem() noexcept {
+  body_.clear();
+  return std::move(item_);
+}
+
+bool SECSMessage::TryDecodeBody(std::pmr::memory_resource *resource) {
+  if (item_ != nullptr || body_.empty()) {
+    return true;
+  }
+  std::span<std::uint8_t> _bytes(body_);
+  std::optional<std::unique_ptr<SECSItemBase>> _item;
+  // the body is exactly one item
+  if (!SECSParser::TryDeserialize(_bytes, _item, resource) ||
+      !_item.has_value() || !_bytes.empty()) {
+    return false;
+  }
+  item_ = std::move(_item.value());
+  body_.clear();
+  body_.shrink_to_fit();
+  return true;
+}
+
+bool SECSMessage::TryEncodeBody() {
+  if (item_ == nullptr) {
+    return true;
+  }
+  body_.clear();
+  return item_->TrySerialize(body_);
+}
+
+std::size_t SECSMessage::EncodedSize() const noexcept {
+  if (item_ == nullptr) {
+    return SECSMessageHeader::Size + body_.size();
+  }
+  auto _size = item_->EncodedSize();
+  if (_size == std::numeric_limits<std::size_t>::max()) {
+    return _size;
+  }
+  return SECSMessageHeader::Size + _size;
+}
+
+bool SECSMessage::TrySerialize(std::vector<std::uint8_t> &bytes) const {
+  auto _size = EncodedSize();
+  if (_size == std::numeric_limits<std::size_t>::max()) {
+    return false;
+  }
+  auto oldSize = bytes.size();
+  try {
+    bytes.resize(oldSize + _size);
+  } catch (...) {
+    return false;
+  }
+  std::span<std::uint8_t> _span(bytes.data() + oldSize, _size);
+  if (!TrySerialize(_span)) {
+    bytes.resize(oldSize);
+    return false;
+  }
+  return true;
+}
+
+bool SECSMessage::TrySerialize(std::span<std::uint8_t> &bytes) const {
+  auto _size = EncodedSize();
+  if (_size == std::numeric_limits<std::size_t>::max() || bytes.size() < _size) {
+    return false;
+  }
+  auto _rest = bytes;
+  header_.TryPack(_rest);
+  if (item_ != nullptr) {
+    if (!item_->TrySerialize(_rest)) {
+      return false;
+    }
+  } else if (!body_.empty()) {
+    std::memcpy(_rest.data(), body_.data(), body_.size());
+  }
+  bytes = bytes.subspan(_size);
+  return true;
+}
+
+bool SECSMessage::TryDeserialize(std::span<const std::uint8_t> bytes,
+                                 SECSMessage &message) {
+  SECSMessageHeader _header;
+  if (!SECSMessageHeader::TryUnpack(bytes, _header)) {
+    return false;
+  }
+  message.header_ = _header;
+  message.item_.reset();
+  message.body_.assign(bytes.begin(), bytes.end());
+  return true;
+}
@@ -0,0 +1,210 @@
+#include "SECSMessageTree.hpp"
+#include "SECSItemView.hpp"
+#include "SECSParser.hpp"
+#include <cstring>
+#include <limits>
+
+namespace {
+constexpr std::size_t MaxLength = 0xFFFFFF;
+} // namespace
+
+std::size_t SECSMessageTree::HeaderSize(std::size_t length) noexcept {
+  if (length < 0x100) {
+    return 2;
+  } else if (length < 0x10000) {
+    return 3;
+  }
+  return 4;
+}
+
+bool SECSMessageTree::TryDeserialize(std::span<const std::uint8_t> &bytes,
+                                     SECSMessageTree &tree) {
+  tree.nodes_.clear();
+  tree.payload_.clear();
+  SECSItemView _root;
+  auto _rest = bytes;
+  if (!SECSItemView::TryParse(_rest, _root)) {
+    return false;
+  }
+  // lists waiting for children: node index and children still to come
+  std::vector<std::pair<std::uint32_t, std::uint32_t>> _open;
+  auto _input = _root.Bytes();
+  std::size_t _offset = 0;
+  do {
+    FormatCode format;
+    std::uint32_t length;
+    std::uint8_t headerSize;
+    SECSItemView::ReadHeader(_input.subspan(_offset), format, length,
+                             headerSize);
+    _offset += headerSize;
+    auto _index = static_cast<std::uint32_t>(tree.nodes_.size());
+    auto &node = tree.nodes_.emplace_back();
+    node.format = format;
+    node.length = length;
+    if (format == FormatCode::ListFormatCode) {
+      if (length != 0) {
+        _open.emplace_back(_index, length);
+        continue;
+      }
+    } else {
+      node.offset = static_cast<std::uint32_t>(tree.payload_.size());
+      tree.payload_.insert(tree.payload_.end(), _input.begin() + _offset,
+                           _input.begin() + _offset + length);
+      _offset += length;
+    }
+    while (!_open.empty() && --_open.back().second == 0) {
+      auto _list = _open.back().first;
+      tree.nodes_[_list].extent =
+          static_cast<std::uint32_t>(tree.nodes_.size() - _list);
+      _open.pop_back();
+    }
+  } while (!_open.empty());
+  bytes = _rest;
+  return true;
+}
+
+bool SECSMessageTree::TryFromItem(SECSItemBase &item, SECSMessageTree &tree) {
+  std::vector<std::uint8_t> _bytes;
+  if (!item.TrySerialize(_bytes)) {
+    return false;
+  }
+  std::span<const std::uint8_t> _span(_bytes);
+  return TryDeserialize(_span, tree);
+}
+
+std::unique_ptr<SECSItemBase>
+SECSMessageTree::ToItem(std::pmr::memory_resource *resource) const {
+  std::vector<std::uint8_t> _bytes;
+  if (!TrySerialize(_bytes)) {
+    return nullptr;
+  }
+  std::span<std::uint8_t> _span(_bytes);
+  std::optional<std::unique_ptr<SECSItemBase>> _item;
+  if (!SECSParser::TryDeserialize(_span, _item, resource) ||
+      !_item.has_value()) {
+    return nullptr;
+  }
+  return std::move(_item.value());
+}
+
+std::size_t SECSMessageTree::EncodedSize() const noexcept {
+  std::size_t _total = payload_.size();
+  for (const auto &node : nodes_) {
+    if (node.length > MaxLength) {
+      return std::numeric_limits<std::size_t>::max();
+    }
+    _total += HeaderSize(node.length);
+  }
+  return _total;
+}
+
+bool SECSMessageTree::TrySerialize(std::vector<std::uint8_t> &bytes) const {
+  auto _size = EncodedSize();
+  if (_size == std::numeric_limits<std::size_t>::max()) {
+    return false;
+  }
+  auto oldSize = bytes.size();
+  try {
+    bytes.resize(oldSize + _size);
+  } catch (...) {
+    return false;
+  }
+  std::span<std::uint8_t> _span(bytes.data() + oldSize, _size);
+  if (!TrySerialize(_span)) {
+    bytes.resize(oldSize);
+    return false;
+  }
+  return true;
+}
+
+bool SECSMessageTree::TrySerialize(std::span<std::uint8_t> &bytes) const noexcept {
+  auto _size = EncodedSize();
+  if (_size == std::numeric_limits<std::size_t>::max() || bytes.size() < _size) {
+    return false;
+  }
+  auto _dst = bytes.data();
+  for (const auto &node : nodes_) {
+    auto _byteLength = static_cast<int>(HeaderSize(node.length) - 1);
+    *_dst++ =
+        static_cast<std::uint8_t>(static_cast<int>(node.format) | _byteLength);
+    for (int i = _byteLength - 1; i >= 0; i--) {
+      *_dst++ = static_cast<std::uint8_t>((node.length >> (i << 3)) & 0xFF);
+    }
+    if (node.format != FormatCode::ListFormatCode && node.length != 0) {
+      std::memcpy(_dst, payload_.data() + node.offset, node.length);
+      _dst += node.length;
+    }
+  }
+  bytes = bytes.subspan(_size);
+  return true;
+}
+
+// Payloads are appended in pre-order, so equal trees have equal payload
+// buffers and node arrays.
+bool SECSMessageTree::operator==(const SECSMessageTree &obj) const noexcept {
+  if (nodes_.size() != obj.nodes_.size() || payload_ != obj.payload_) {
+    return false;
+  }
+  for (std::size_t i = 0; i < nodes_.size(); i++) {
+    const auto &a = nodes_[i], &b = obj.nodes_[i];
+    if (a.format != b.format || a.length != b.length ||
+        a.extent != b.extent) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void SECSMessageTree::Builder::Reserve(std::size_t nodes,
+                                       std::size_t payloadBytes) {
+  tree_.nodes_.reserve(nodes);
+  tree_.payload_.reserve(payloadBytes);
+}
+
+void SECSMessageTree::Builder::BeginList() {
+  if (!open_.empty()) {
+    ++tree_.nodes_[open_.back()].length;
+  }
+  open_.push_back(static_cast<std::uint32_t>(tree_.nodes_.size()));
+  tree_.nodes_.push_back({FormatCode::ListFormatCode, 0, 0, 1});
+}
+
+bool SECSMessageTree::Builder::EndList() noexcept {
+  if (open_.empty()) {
+    return false;
+  }
+  auto _list = open_.back();
+  open_.pop_back();
+  tree_.nodes_[_list].extent =
+      static_cast<std::uint32_t>(tree_.nodes_.size() - _list);
+  return true;
+}
+
+bool SECSMessageTree::Builder::AddLeaf(FormatCode format,
+                                       const std::uint8_t *data,
+                                       std::size_t size) {
+  if (size > MaxLength) {
+    return false;
+  }
+  if (!open_.empty()) {
+    ++tree_.nodes_[open_.back()].length;
+  }
+  auto _offset = tree_.payload_.size();
+  tree_.nodes_.push_back({format, static_cast<std::uint32_t>(size),
+                          static_cast<std::uint32_t>(_offset), 1});
+  tree_.payload_.resize(_offset + size);
+  if (data && size != 0) {
+    std::memcpy(tree_.payload_.data() + _offset, data, size);
+  }
+  return true;
+}
+
+bool SECSMessageTree::Builder::TryBuild(SECSMessageTree &tree) {
+  auto &nodes = tree_.nodes_;
+  if (!open_.empty() || (!nodes.empty() && nodes[0].extent != nodes.size())) {
+    return false;
+  }
+  tree = std::move(tree_);
+  tree_ = SECSMessageTree{};
+  return true;
+}
@@ -0,0 +1,18 @@
+#include "SECSParser.hpp"
+#include "ListItem.hpp"
+
+bool SECSParser::TryDeserializeLazy(std::span<std::uint8_t> &bytes,
+                                    ParseResult &_item,
+                                    std::pmr::memory_resource *resource) {
+  std::uint32_t length = 0;
+  if (!TryCreateItem(bytes, _item, length, resource)) {
+    return false;
+  }
+  if (!_item.has_value()) {
+    return true;
+  }
+  if (auto _list = _item.value()->As<ListItem>()) {
+    return _list->DeserializeLazy(bytes, static_cast<int>(length));
+  }
+  return _item.value()->TryDeserialize(bytes, static_cast<int>(length));
+}
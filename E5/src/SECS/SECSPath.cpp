@@ -0,0 +1,70 @@
+#include "SECSPath.hpp"
+#include <charconv>
+
+bool SECSPath::TryParseStep(std::string_view token, std::vector<Step> &steps) {
+  auto _selector = [&](std::string_view text) {
+    if (text == "*") {
+      steps.push_back({StepKind::Any, FormatCode::None, 0});
+      return true;
+    }
+    std::uint32_t _index = 0;
+    auto _last = text.data() + text.size();
+    auto [ptr, err] = std::from_chars(text.data(), _last, _index);
+    if (text.empty() || err != std::errc{} || ptr != _last) {
+      return false;
+    }
+    steps.push_back({StepKind::Index, FormatCode::None, _index});
+    return true;
+  };
+  auto _open = token.find('[');
+  auto _name = token.substr(0, _open);
+  if (_open == 0) {
+    return false;
+  }
+  if (_open == std::string_view::npos && _selector(_name)) {
+    return true;
+  }
+  auto _format = CodeNameExtension::TryGetNameCode(_name);
+  if (_format == FormatCode::None) {
+    return false;
+  }
+  steps.push_back({StepKind::Format, _format, 0});
+  while (_open != std::string_view::npos) {
+    auto _close = token.find(']', _open);
+    if (_close == std::string_view::npos ||
+        !_selector(token.substr(_open + 1, _close - _open - 1))) {
+      return false;
+    }
+    if (_close + 1 == token.size()) {
+      break;
+    }
+    if (token[_close + 1] != '[') {
+      return false;
+    }
+    _open = _close + 1;
+  }
+  return true;
+}
+
+bool SECSPath::TryCompile(std::string_view text, SECSPath &path) {
+  path.steps_.clear();
+  if (text.starts_with('/')) {
+    text.remove_prefix(1);
+  }
+  if (text.empty()) {
+    return true;
+  }
+  std::vector<Step> _steps;
+  for (;;) {
+    auto _end = text.find('/');
+    if (!TryParseStep(text.substr(0, _end), _steps)) {
+      return false;
+    }
+    if (_end == std::string_view::npos) {
+      break;
+    }
+    text.remove_prefix(_end + 1);
+  }
+  path.steps_ = std::move(_steps);
+  return true;
+}
@@ -0,0 +1,43 @@
+#include "SECSReplyTemplate.hpp"
+#include "SECSParser.hpp"
+#include "SECSPath.hpp"
+
+bool SECSReplyTemplate::TryCompile(
+    SECSItemBase &item, std::initializer_list<std::string_view> slotPaths,
+    SECSReplyTemplate &reply) {
+  reply.bytes_.clear();
+  reply.slots_.clear();
+  if (!item.TrySerialize(reply.bytes_)) {
+    return false;
+  }
+  std::span<const std::uint8_t> _bytes(reply.bytes_);
+  // freshly serialized, so every slot path is resolved without validation
+  auto _root = SECSItemView::FromValidated(_bytes);
+  reply.slots_.reserve(slotPaths.size());
+  for (auto _text : slotPaths) {
+    SECSPath _path;
+    SECSItemView _leaf;
+    if (!SECSPath::TryCompile(_text, _path) ||
+        !_path.TryFind(_root, _leaf) || _leaf.IsList()) {
+      reply.bytes_.clear();
+      reply.slots_.clear();
+      return false;
+    }
+    auto _payload = _leaf.Payload();
+    reply.slots_.push_back(
+        {_leaf.Format(),
+         static_cast<std::uint32_t>(_payload.data() - _bytes.data()),
+         static_cast<std::uint32_t>(_payload.size())});
+  }
+  return true;
+}
+
+bool SECSReplyTemplate::TryCompile(
+    std::string_view sml, std::initializer_list<std::string_view> slotPaths,
+    SECSReplyTemplate &reply) {
+  auto _item = SECSParser::TryParseContent(sml);
+  if (!_item.has_value() || !_item.value()) {
+    return false;
+  }
+  return TryCompile(*_item.value(), slotPaths, reply);
+}
@@ -0,0 +1,156 @@
+#include "SECSStreamDecoder.hpp"
+#include "FormatCode.hpp"
+#include "ListItem.hpp"
+#include "SECSFactory.hpp"
+#include <algorithm>
+
+SECSStreamDecoder::SECSStreamDecoder(std::size_t maxDepth,
+                                     std::pmr::memory_resource *resource)
+    : max_depth_(maxDepth), resource_(resource) {
+  stack_.reserve(maxDepth);
+}
+
+void SECSStreamDecoder::Reset() noexcept {
+  root_.reset();
+  stack_.clear();
+  header_fill_ = 0;
+  leaf_ = nullptr;
+  leaf_remain_ = 0;
+  carry_size_ = 0;
+  status_ = Status::NeedMore;
+}
+
+std::unique_ptr<SECSItemBase> SECSStreamDecoder::Take() {
+  if (status_ != Status::Complete) {
+    return nullptr;
+  }
+  auto _item = std::move(root_);
+  Reset();
+  return _item;
+}
+
+bool SECSStreamDecoder::BeginItem() {
+  int lengthBytesLength = header_[0] & LengthBytesCountFilter;
+  std::uint32_t length = 0;
+  for (int i = 1; i <= lengthBytesLength; ++i) {
+    length = (length << 8) | header_[i];
+  }
+  auto _formatCode = static_cast<FormatCode>(header_[0] & FormatCodeFilter);
+  auto _item = SECSFactory::createItem(_formatCode, resource_);
+  if (!_item) {
+    return false;
+  }
+  SECSItemBase *_raw = _item.get();
+  if (stack_.empty()) {
+    root_ = std::move(_item);
+  } else {
+    stack_.back().list->Append(std::move(_item));
+  }
+  if (_formatCode == FormatCode::ListFormatCode) {
+    if (length == 0) {
+      EndItem();
+      return true;
+    }
+    if (stack_.size() >= max_depth_) {
+      return false;
+    }
+    stack_.push_back({static_cast<ListItem *>(_raw), length});
+    return true;
+  }
+  if (length == 0) {
+    std::span<std::uint8_t> _empty;
+    if (!_raw->TryDeserialize(_empty, 0)) {
+      return false;
+    }
+    EndItem();
+    return true;
+  }
+  // storage grows in FillLeaf with the bytes that arrive, so a declared
+  // length alone never allocates
+  leaf_width_ = _raw->ElementWidth();
+  if (leaf_width_ == 0 || leaf_width_ > carry_.size() ||
+      length % leaf_width_ != 0) {
+    return false;
+  }
+  leaf_ = _raw;
+  leaf_remain_ = length;
+  leaf_index_ = 0;
+  carry_size_ = 0;
+  return true;
+}
+
+bool SECSStreamDecoder::FillLeaf(std::span<std::uint8_t> &chunk) {
+  auto _take = std::min<std::size_t>(chunk.size(), leaf_remain_);
+  auto _elements = (leaf_index_ * leaf_width_ + carry_size_ + _take) /
+                   leaf_width_;
+  if (_elements > leaf_index_ &&
+      !leaf_->TryResizePayload(_elements * leaf_width_)) {
+    return false;
+  }
+  auto _src = chunk.data();
+  auto _left = _take;
+  chunk = chunk.subspan(_take);
+  leaf_remain_ -= static_cast<std::uint32_t>(_take);
+  // finish the element begun at the end of the previous chunk
+  if (carry_size_ != 0) {
+    auto _fill = std::min(leaf_width_ - carry_size_, _left);
+    std::copy_n(_src, _fill, carry_.data() + carry_size_);
+    carry_size_ += _fill;
+    _src += _fill;
+    _left -= _fill;
+    if (carry_size_ < leaf_width_) {
+      return true;
+    }
+    leaf_->LoadElements(leaf_index_++, carry_.data(), 1);
+    carry_size_ = 0;
+  }
+  auto _count = _left / leaf_width_;
+  leaf_->LoadElements(leaf_index_, _src, _count);
+  leaf_index_ += _count;
+  _src += _count * leaf_width_;
+  _left -= _count * leaf_width_;
+  std::copy_n(_src, _left, carry_.data());
+  carry_size_ = _left;
+  if (leaf_remain_ == 0) {
+    leaf_ = nullptr;
+    EndItem();
+  }
+  return true;
+}
+
+void SECSStreamDecoder::EndItem() noexcept {
+  while (!stack_.empty()) {
+    if (--stack_.back().remain != 0) {
+      return;
+    }
+    stack_.pop_back();
+  }
+  status_ = Status::Complete;
+}
+
+SECSStreamDecoder::Status
+SECSStreamDecoder::Feed(std::span<std::uint8_t> &chunk) {
+  while (status_ == Status::NeedMore && !chunk.empty()) {
+    if (leaf_) {
+      if (!FillLeaf(chunk)) {
+        status_ = Status::Error;
+      }
+      continue;
+    }
+    header_[header_fill_++] = chunk[0];
+    chunk = chunk.subspan(1);
+    auto lengthBytesLength = header_[0] & LengthBytesCountFilter;
+    if (lengthBytesLength == 0) {
+      status_ = Status::Error;
+      break;
+    }
+    if (header_fill_ < static_cast<std::size_t>(lengthBytesLength) + 1) {
+      continue;
+    }
+    header_fill_ = 0;
+    if (!BeginItem()) {
+      status_ = Status::Error;
+    }
+  }
+  return status_;
+}
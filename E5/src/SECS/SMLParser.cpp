@@ -0,0 +1,138 @@
+#include "SMLParser.hpp"
+#include "FormatCode.hpp"
+#include "ListItem.hpp"
+#include "SECSFactory.hpp"
+#include <cctype>
+
+namespace {
+class SMLReader {
+private:
+  static constexpr char RangeStartMark = '<';
+  static constexpr char RangeEndMark = '>';
+  std::string_view text_;
+  std::size_t pos_ = 0;
+  int depth_ = 0;
+  SMLParseError *error_;
+  std::pmr::memory_resource *resource_;
+
+  static bool IsNameChar(char c) noexcept {
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '|' ||
+           c == '*' || c == '?';
+  }
+  bool Fail(std::size_t offset, std::string_view reason) noexcept {
+    if (error_) {
+      error_->offset = offset;
+      error_->reason = reason;
+    }
+    return false;
+  }
+  void SkipSpace() noexcept {
+    while (pos_ < text_.size() &&
+           std::isspace(static_cast<unsigned char>(text_[pos_]))) {
+      ++pos_;
+    }
+  }
+
+public:
+  SMLReader(std::string_view text, SMLParseError *error,
+            std::pmr::memory_resource *resource) noexcept
+      : text_(text), error_(error), resource_(resource) {}
+
+  bool AtEnd() noexcept {
+    SkipSpace();
+    return pos_ >= text_.size() || Fail(pos_, "unexpected trailing text");
+  }
+  std::unique_ptr<SECSItemBase> ReadItem() {
+    SkipSpace();
+    if (pos_ >= text_.size() || text_[pos_] != RangeStartMark) {
+      Fail(pos_, "expected '<'");
+      return nullptr;
+    }
+    const std::size_t _nameStart = ++pos_;
+    while (pos_ < text_.size() && IsNameChar(text_[pos_])) {
+      ++pos_;
+    }
+    auto _name = text_.substr(_nameStart, pos_ - _nameStart);
+    if (_name.empty()) {
+      Fail(_nameStart, "missing item type");
+      return nullptr;
+    }
+    auto _formatCode = CodeNameExtension::TryGetNameCode(_name);
+    if (_formatCode == FormatCode::None) {
+      Fail(_nameStart, "unknown item type");
+      return nullptr;
+    }
+    auto _item = SECSFactory::createItem(_formatCode, resource_);
+    if (!_item) {
+      Fail(_nameStart, "unknown item type");
+      return nullptr;
+    }
+    if (_formatCode == FormatCode::ListFormatCode) {
+      if (depth_ >= SMLParser::MaxDepth) {
+        Fail(_nameStart, "nesting too deep");
+        return nullptr;
+      }
+      ++depth_;
+      bool _ok = ReadItems(static_cast<ListItem &>(*_item));
+      --depth_;
+      if (!_ok) {
+        return nullptr;
+      }
+      if (pos_ >= text_.size()) {
+        Fail(pos_, "expected '>'");
+        return nullptr;
+      }
+      ++pos_;
+      return _item;
+    }
+    const std::size_t _contentStart = pos_;
+    auto _end = text_.find(RangeEndMark, pos_);
+    if (_end == std::string_view::npos) {
+      Fail(text_.size(), "expected '>'");
+      return nullptr;
+    }
+    if (!_item->TryParseContent(
+            text_.substr(_contentStart, _end - _contentStart))) {
+      Fail(_contentStart, "invalid item content");
+      return nullptr;
+    }
+    pos_ = _end + 1;
+    return _item;
+  }
+  // Stops in front of the closing '>' or at the end of the text.
+  bool ReadItems(ListItem &list) {
+    list.Clear();
+    for (;;) {
+      SkipSpace();
+      if (pos_ >= text_.size() || text_[pos_] == RangeEndMark) {
+        return true;
+      }
+      if (text_[pos_] != RangeStartMark) {
+        return Fail(pos_, "expected '<' or '>'");
+      }
+      auto _child = ReadItem();
+      if (!_child) {
+        return false;
+      }
+      list.Append(std::move(_child));
+    }
+  }
+};
+} // namespace
+
+SMLParser::ParseResult SMLParser::Parse(std::string_view text,
+                                        SMLParseError *error,
+                                        std::pmr::memory_resource *resource) {
+  SMLReader reader(text, error, resource);
+  auto _item = reader.ReadItem();
+  if (!_item || !reader.AtEnd()) {
+    return std::nullopt;
+  }
+  return _item;
+}
+
+bool SMLParser::ParseItems(std::string_view text, ListItem &list,
+                           SMLParseError *error) {
+  SMLReader reader(text, error, list.Resource());
+  return reader.ReadItems(list) && reader.AtEnd();
+}
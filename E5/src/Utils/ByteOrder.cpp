@@ -0,0 +1,115 @@
+#include "ByteOrder.hpp"
+#include <array>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SEMI_BYTEORDER_X86 1
+#endif
+
+namespace {
+using SwapKernel = void (*)(std::uint8_t *, const std::uint8_t *,
+                            std::size_t) noexcept;
+
+template <std::size_t Width>
+void SwapScalar(std::uint8_t *dst, const std::uint8_t *src,
+                std::size_t count) noexcept {
+  using raw = std::conditional_t<
+      Width == 2, std::uint16_t,
+      std::conditional_t<Width == 4, std::uint32_t, std::uint64_t>>;
+  for (std::size_t i = 0; i < count; i++) {
+    raw _value;
+    std::memcpy(&_value, src + i * Width, Width);
+    _value = std::byteswap(_value);
+    std::memcpy(dst + i * Width, &_value, Width);
+  }
+}
+
+#ifdef SEMI_BYTEORDER_X86
+// pshufb control reversing every Width-byte group of a 16-byte lane.
+template <std::size_t Width, std::size_t Bytes>
+constexpr std::array<std::uint8_t, Bytes> MakeSwapMask() {
+  std::array<std::uint8_t, Bytes> mask{};
+  for (std::size_t i = 0; i < Bytes; i++) {
+    std::size_t _lane = i % 16;
+    mask[i] = static_cast<std::uint8_t>((_lane / Width) * Width + Width - 1 -
+                                        _lane % Width);
+  }
+  return mask;
+}
+
+template <std::size_t Width>
+__attribute__((target("ssse3"))) void
+SwapSSSE3(std::uint8_t *dst, const std::uint8_t *src,
+          std::size_t count) noexcept {
+  alignas(16) static constexpr auto table = MakeSwapMask<Width, 16>();
+  const __m128i mask =
+      _mm_load_si128(reinterpret_cast<const __m128i *>(table.data()));
+  const std::size_t _bytes = count * Width;
+  std::size_t i = 0;
+  for (; i + 16 <= _bytes; i += 16) {
+    __m128i _value =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i),
+                     _mm_shuffle_epi8(_value, mask));
+  }
+  SwapScalar<Width>(dst + i, src + i, (_bytes - i) / Width);
+}
+
+template <std::size_t Width>
+__attribute__((target("avx2"))) void
+SwapAVX2(std::uint8_t *dst, const std::uint8_t *src,
+         std::size_t count) noexcept {
+  alignas(32) static constexpr auto table = MakeSwapMask<Width, 32>();
+  const __m256i mask =
+      _mm256_load_si256(reinterpret_cast<const __m256i *>(table.data()));
+  const std::size_t _bytes = count * Width;
+  std::size_t i = 0;
+  for (; i + 64 <= _bytes; i += 64) {
+    __m256i _low =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+    __m256i _high =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i + 32));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i),
+                        _mm256_shuffle_epi8(_low, mask));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i + 32),
+                        _mm256_shuffle_epi8(_high, mask));
+  }
+  for (; i + 32 <= _bytes; i += 32) {
+    __m256i _value =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i),
+                        _mm256_shuffle_epi8(_value, mask));
+  }
+  SwapScalar<Width>(dst + i, src + i, (_bytes - i) / Width);
+}
+#endif
+
+template <std::size_t Width> SwapKernel SelectKernel() noexcept {
+#ifdef SEMI_BYTEORDER_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return &SwapAVX2<Width>;
+  }
+  if (__builtin_cpu_supports("ssse3")) {
+    return &SwapSSSE3<Width>;
+  }
+#endif
+  return &SwapScalar<Width>;
+}
+} // namespace
+
+template <std::size_t Width>
+void ByteOrder::SwapCopy(std::uint8_t *dst, const std::uint8_t *src,
+                         std::size_t count) noexcept {
+  static_assert(Width == 2 || Width == 4 || Width == 8,
+                "Only for 2, 4 and 8 byte elements");
+  static const SwapKernel kernel = SelectKernel<Width>();
+  kernel(dst, src, count);
+}
+
+template void ByteOrder::SwapCopy<2>(std::uint8_t *, const std::uint8_t *,
+                                     std::size_t) noexcept;
+template void ByteOrder::SwapCopy<4>(std::uint8_t *, const std::uint8_t *,
+                                     std::size_t) noexcept;
+template void ByteOrder::SwapCopy<8>(std::uint8_t *, const std::uint8_t *,
+                                     std::size_t) noexcept;
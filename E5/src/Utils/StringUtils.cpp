@@ -0,0 +1,83 @@
+#include "StringUtils.hpp"
+#include <bit>
+#include <cstdint>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define SEMI_STRINGUTILS_SSE2 1
+#endif
+
+namespace {
+#ifdef SEMI_STRINGUTILS_SSE2
+// Bit i is set when str[i] is a splitter: ' ' or one of '\a'..'\r'.
+inline std::uint32_t SplitterMask(const char *str) noexcept {
+  const __m128i _chars =
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(str));
+  const __m128i _space = _mm_cmpeq_epi8(_chars, _mm_set1_epi8(' '));
+  // '\a'..'\r' are 7..13: after subtracting 7 they are the only bytes that
+  // saturate to zero when 6 is subtracted again
+  const __m128i _control = _mm_cmpeq_epi8(
+      _mm_subs_epu8(_mm_sub_epi8(_chars, _mm_set1_epi8(7)), _mm_set1_epi8(6)),
+      _mm_setzero_si128());
+  return static_cast<std::uint32_t>(
+      _mm_movemask_epi8(_mm_or_si128(_space, _control)));
+}
+#endif
+} // namespace
+
+const char *StringUtils::FindSplitter(const char *first,
+                                      const char *last) noexcept {
+#ifdef SEMI_STRINGUTILS_SSE2
+  for (; last - first >= 16; first += 16) {
+    auto _mask = SplitterMask(first);
+    if (_mask != 0) {
+      return first + std::countr_zero(_mask);
+    }
+  }
+#endif
+  while (first < last && !IsSplitter(*first)) {
+    ++first;
+  }
+  return first;
+}
+
+const char *StringUtils::SkipSplitters(const char *first,
+                                       const char *last) noexcept {
+#ifdef SEMI_STRINGUTILS_SSE2
+  for (; last - first >= 16; first += 16) {
+    auto _mask = SplitterMask(first) ^ 0xFFFFu;
+    if (_mask != 0) {
+      return first + std::countr_zero(_mask);
+    }
+  }
+#endif
+  while (first < last && IsSplitter(*first)) {
+    ++first;
+  }
+  return first;
+}
+
+std::size_t StringUtils::CountTokens(std::string_view str) noexcept {
+  const char *_first = str.data();
+  const char *_last = _first + str.size();
+  std::size_t _count = 0;
+  // whether the byte before _first was a splitter; the start counts as one
+  bool _previous = true;
+#ifdef SEMI_STRINGUTILS_SSE2
+  for (; _last - _first >= 16; _first += 16) {
+    auto _mask = SplitterMask(_first);
+    // a token starts at every non-splitter preceded by a splitter
+    auto _starts = ~_mask & ((_mask << 1) | (_previous ? 1u : 0u)) & 0xFFFFu;
+    _count += static_cast<std::size_t>(std::popcount(_starts));
+    _previous = (_mask >> 15) != 0;
+  }
+#endif
+  for (; _first < _last; ++_first) {
+    bool _splitter = IsSplitter(*_first);
+    if (!_splitter && _previous) {
+      ++_count;
+    }
+    _previous = _splitter;
+  }
+  return _count;
+}
@@ -83,7 +83,7 @@ private:
     return lca;
   }
   using state_handler = std::unique_ptr<IStateChangeHandler<TIndex>>;
-  std::unique_ptr<bool> alive_ = std::make_unique<bool>(true);
+  std::shared_ptr<bool> alive_ = std::make_shared<bool>(true);
   std::size_t version_ = 0;
 
 public:
@@ -30,8 +30,8 @@ public:
   explicit Transition(State<TIndex> &departure, State<TIndex> &destination,
                       RequirementMonitor *requirement,
                       HandlerCallbackType callback, bool enter_history)
-      : departure_(&departure), destination_(&destination),
-        requirement_(requirement), handler_(std::move(callback)),
+      : handler_(std::move(callback)), departure_(&departure),
+        destination_(&destination), requirement_(requirement),
         enter_history_(enter_history) {}
   virtual ~Transition() = default;
 
@@ -17,6 +17,7 @@ private:
 public:
   std::uint64_t TargetTick() const;
   std::uint64_t GetID() const;
+  bool Cancelled() const noexcept { return cancel_token_.stop_requested(); }
   TimeDelay(Action action, std::stop_token cancel_token,
             std::uint64_t targettick);
   void DoAction();
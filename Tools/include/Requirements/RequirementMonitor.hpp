@@ -13,7 +13,7 @@ private:
   std::vector<std::pair<std::size_t, CallbackType>> listeners_;
   int monitorCounter_{0};
   bool fulfilled_{false};
-  std::unique_ptr<bool> alive_;
+  std::shared_ptr<bool> alive_;
   std::size_t id_{0};
 
 public:
@@ -64,7 +64,7 @@ public:
       return *this;
     }
   };
-  RequirementMonitor() : alive_(std::make_unique<bool>(true)) {}
+  RequirementMonitor() : alive_(std::make_shared<bool>(true)) {}
   virtual ~RequirementMonitor() {
     if (alive_) {
       *alive_ = false;